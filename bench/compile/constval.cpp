@@ -0,0 +1,57 @@
+
+// Compile-time stress test: `MAKESHIFT_CONSTVAL()` of arrays with 1024 elements.
+
+#include <array>
+#include <cstddef>      // for size_t
+
+#include <makeshift/constval.hpp>  // for MAKESHIFT_CONSTVAL(), array_constant<>
+
+
+namespace bench {
+
+namespace mk = ::makeshift;
+
+
+constexpr std::size_t numElements = 1024;
+
+template <typename T>
+constexpr std::array<T, numElements>
+make_elements(T factor)
+{
+    auto result = std::array<T, numElements>{ };
+    for (std::size_t i = 0; i != numElements; ++i)
+    {
+        result[i] = T(i)*factor;
+    }
+    return result;
+}
+
+
+int
+sum_int_elements(void)
+{
+    auto elementsC = MAKESHIFT_CONSTVAL(bench::make_elements(3));
+    constexpr auto elements = elementsC();
+    int result = 0;
+    for (int element : elements)
+    {
+        result += element;
+    }
+    return result;
+}
+
+double
+sum_double_elements(void)
+{
+    auto elementsC = MAKESHIFT_CONSTVAL(bench::make_elements(0.5));
+    constexpr auto elements = elementsC();
+    double result = 0;
+    for (double element : elements)
+    {
+        result += element;
+    }
+    return result;
+}
+
+
+} // namespace bench
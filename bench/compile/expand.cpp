@@ -0,0 +1,44 @@
+
+// Compile-time stress test: `expand_compact()` over an array of 1000 values. (`expand()` would return a `std::variant<>` with
+// 1000 alternatives, which exceeds the default instantiation depth of some standard libraries.)
+
+#include <array>
+#include <cstddef>      // for size_t
+
+#include <makeshift/constval.hpp>  // for MAKESHIFT_CONSTVAL()
+#include <makeshift/variant.hpp>   // for expand_compact(), visit()
+
+
+namespace bench {
+
+namespace mk = ::makeshift;
+
+
+constexpr std::size_t numValues = 1000;
+
+constexpr std::array<int, numValues>
+make_values(void)
+{
+    auto result = std::array<int, numValues>{ };
+    for (std::size_t i = 0; i != numValues; ++i)
+    {
+        result[i] = int(i*i % 7919);
+    }
+    return result;
+}
+
+
+int
+expand_and_visit(int value)
+{
+    auto valueV = mk::expand_compact(value, MAKESHIFT_CONSTVAL(bench::make_values()));
+    return mk::visit(
+        [](auto valueC)
+        {
+            return valueC()*2;
+        },
+        valueV);
+}
+
+
+} // namespace bench
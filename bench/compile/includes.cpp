@@ -0,0 +1,8 @@
+
+// Compile-time baseline: includes the headers used by the stress tests without instantiating anything.
+
+#include <makeshift/array.hpp>
+#include <makeshift/tuple.hpp>
+#include <makeshift/variant.hpp>
+#include <makeshift/constval.hpp>
+#include <makeshift/metadata.hpp>
@@ -0,0 +1,85 @@
+
+// Compile-time stress test: reflection metadata of a struct with `MAKESHIFT_BENCH_NUM_MEMBERS` (50, 200, or 500) members.
+// Members are retrieved as a `value_tuple<>` because `std::tuple<>` exceeds the default instantiation depth of some standard
+// libraries for 500 elements.
+
+#include <tuple>
+#include <string_view>
+
+#include <gsl-lite/gsl-lite.hpp>  // for type_identity<>
+
+#include <makeshift/tuple.hpp>     // for value_tuple<>, template_for()
+#include <makeshift/metadata.hpp>  // for members<>(), member_names<>()
+
+
+#ifndef MAKESHIFT_BENCH_NUM_MEMBERS
+# define MAKESHIFT_BENCH_NUM_MEMBERS 50
+#endif // MAKESHIFT_BENCH_NUM_MEMBERS
+
+#define MAKESHIFT_BENCH_REPEAT_10_(M, P) M(P##0) M(P##1) M(P##2) M(P##3) M(P##4) M(P##5) M(P##6) M(P##7) M(P##8) M(P##9)
+#define MAKESHIFT_BENCH_REPEAT_100_(M, P) \
+    MAKESHIFT_BENCH_REPEAT_10_(M, P##0) MAKESHIFT_BENCH_REPEAT_10_(M, P##1) MAKESHIFT_BENCH_REPEAT_10_(M, P##2) \
+    MAKESHIFT_BENCH_REPEAT_10_(M, P##3) MAKESHIFT_BENCH_REPEAT_10_(M, P##4) MAKESHIFT_BENCH_REPEAT_10_(M, P##5) \
+    MAKESHIFT_BENCH_REPEAT_10_(M, P##6) MAKESHIFT_BENCH_REPEAT_10_(M, P##7) MAKESHIFT_BENCH_REPEAT_10_(M, P##8) \
+    MAKESHIFT_BENCH_REPEAT_10_(M, P##9)
+
+#if MAKESHIFT_BENCH_NUM_MEMBERS == 50
+# define MAKESHIFT_BENCH_MEMBERS_(M) \
+    MAKESHIFT_BENCH_REPEAT_10_(M, m0) MAKESHIFT_BENCH_REPEAT_10_(M, m1) MAKESHIFT_BENCH_REPEAT_10_(M, m2) \
+    MAKESHIFT_BENCH_REPEAT_10_(M, m3) MAKESHIFT_BENCH_REPEAT_10_(M, m4)
+#elif MAKESHIFT_BENCH_NUM_MEMBERS == 200
+# define MAKESHIFT_BENCH_MEMBERS_(M) \
+    MAKESHIFT_BENCH_REPEAT_100_(M, m0) MAKESHIFT_BENCH_REPEAT_100_(M, m1)
+#elif MAKESHIFT_BENCH_NUM_MEMBERS == 500
+# define MAKESHIFT_BENCH_MEMBERS_(M) \
+    MAKESHIFT_BENCH_REPEAT_100_(M, m0) MAKESHIFT_BENCH_REPEAT_100_(M, m1) MAKESHIFT_BENCH_REPEAT_100_(M, m2) \
+    MAKESHIFT_BENCH_REPEAT_100_(M, m3) MAKESHIFT_BENCH_REPEAT_100_(M, m4)
+#else
+# error MAKESHIFT_BENCH_NUM_MEMBERS must be 50, 200, or 500
+#endif
+
+#define MAKESHIFT_BENCH_DECLARE_MEMBER_(NAME) int NAME;
+#define MAKESHIFT_BENCH_REFLECT_MEMBER_(NAME) makeshift::value_tuple{ &Record::NAME, #NAME },
+
+
+namespace bench {
+
+namespace mk = ::makeshift;
+namespace gsl = ::gsl_lite;
+
+
+struct Record
+{
+    MAKESHIFT_BENCH_MEMBERS_(MAKESHIFT_BENCH_DECLARE_MEMBER_)
+    int last;
+};
+constexpr auto
+reflect(gsl::type_identity<Record>)
+{
+    return mk::value_tuple{
+        "Record",
+        mk::make_value_tuple(
+            MAKESHIFT_BENCH_MEMBERS_(MAKESHIFT_BENCH_REFLECT_MEMBER_)
+            mk::value_tuple{ &Record::last, "last" })
+    };
+}
+
+static_assert(std::tuple_size_v<std::remove_cvref_t<decltype(mk::metadata::members<mk::value_tuple, Record>())>> == MAKESHIFT_BENCH_NUM_MEMBERS + 1);
+static_assert(mk::metadata::member_names<Record>()[MAKESHIFT_BENCH_NUM_MEMBERS] == "last");
+
+
+int
+sum_members(Record const& record)
+{
+    int result = 0;
+    mk::template_for(
+        [&](auto member)
+        {
+            result += record.*member;
+        },
+        mk::metadata::members<mk::value_tuple, Record>());
+    return result;
+}
+
+
+} // namespace bench
@@ -0,0 +1,39 @@
+
+# makeshift C++ library
+# Author: Moritz Beutel
+# prints the compile times measured by time-compile.cmake and writes them to a CSV file
+#
+# usage: cmake -D CASES=<case>|<feature>|... -D OUTPUT_DIR=<dir> -D CSV_FILE=<file> -P report.cmake
+
+
+cmake_minimum_required(VERSION 3.30)
+
+string(REPLACE "|" ";" CASES "${CASES}")
+set(_csv "case,feature,milliseconds\n")
+set(_baseline "")
+message("makeshift compile-time benchmarks:")
+while(CASES)
+    list(POP_FRONT CASES _case _feature)
+    if(NOT EXISTS "${OUTPUT_DIR}/${_case}.ms")
+        message(FATAL_ERROR "No compile time recorded for stress test '${_case}'")
+    endif()
+    file(READ "${OUTPUT_DIR}/${_case}.ms" _milliseconds)
+    if(_baseline STREQUAL "")
+        # The first case only includes the headers; its time is subtracted from the other cases.
+        set(_baseline ${_milliseconds})
+        set(_delta "")
+    else()
+        math(EXPR _delta "${_milliseconds} - ${_baseline}")
+        if(_delta GREATER_EQUAL 0)
+            set(_delta "+${_delta}")
+        endif()
+        set(_delta " (${_delta} ms over baseline)")
+    endif()
+    string(LENGTH "${_case}" _length)
+    math(EXPR _padLength "32 - ${_length}")
+    string(REPEAT " " ${_padLength} _pad)
+    message("    ${_case}${_pad}${_milliseconds} ms${_delta}  [${_feature}]")
+    string(APPEND _csv "${_case},${_feature},${_milliseconds}\n")
+endwhile()
+file(WRITE "${CSV_FILE}" "${_csv}")
+message("Results written to ${CSV_FILE}")
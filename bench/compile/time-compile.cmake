@@ -0,0 +1,42 @@
+
+# makeshift C++ library
+# Author: Moritz Beutel
+# compiler launcher which measures the wall-clock time taken to compile a stress test
+#
+# usage: cmake -D CASE=<name> -D OUTPUT_DIR=<dir> -P time-compile.cmake -- <compiler> <args>...
+
+
+cmake_minimum_required(VERSION 3.30)
+
+set(_command "")
+set(_append OFF)
+math(EXPR _lastArg "${CMAKE_ARGC} - 1")
+foreach(_i RANGE ${_lastArg})
+    if(_append)
+        list(APPEND _command "${CMAKE_ARGV${_i}}")
+    elseif(CMAKE_ARGV${_i} STREQUAL "--")
+        set(_append ON)
+    endif()
+endforeach()
+if(NOT _command)
+    message(FATAL_ERROR "time-compile.cmake: no compiler command given")
+endif()
+
+string(TIMESTAMP _start "%s%f" UTC)
+execute_process(
+    COMMAND ${_command}
+    RESULT_VARIABLE _result
+    OUTPUT_VARIABLE _output
+    ERROR_VARIABLE _output
+)
+string(TIMESTAMP _end "%s%f" UTC)
+math(EXPR _milliseconds "(${_end} - ${_start}) / 1000")
+
+# Compiler output (e.g. from GCC's `-ftime-report`) is kept in a log file and only shown if compilation fails.
+file(WRITE "${OUTPUT_DIR}/${CASE}.log" "${_output}")
+if(NOT _result EQUAL 0)
+    message("${_output}")
+    file(REMOVE "${OUTPUT_DIR}/${CASE}.ms")
+    message(FATAL_ERROR "Compiling stress test '${CASE}' failed with exit code ${_result}")
+endif()
+file(WRITE "${OUTPUT_DIR}/${CASE}.ms" "${_milliseconds}")
@@ -0,0 +1,67 @@
+
+// Compile-time stress test: `template_for()` and `tuple_transform()` over tuples with 256 elements of distinct types.
+
+#include <tuple>
+#include <cstddef>      // for size_t
+#include <utility>      // for index_sequence<>, make_index_sequence<>
+
+#include <makeshift/tuple.hpp>  // for template_for(), tuple_transform()
+
+
+namespace bench {
+
+namespace mk = ::makeshift;
+
+
+constexpr std::size_t numElements = 256;
+
+template <std::size_t I>
+struct Element
+{
+    int value;
+};
+
+template <std::size_t... Is>
+constexpr std::tuple<Element<Is>...>
+make_elements(std::index_sequence<Is...>)
+{
+    return { Element<Is>{ int(Is) }... };
+}
+
+
+int
+sum_elements(void)
+{
+    auto elements = bench::make_elements(std::make_index_sequence<numElements>{ });
+    int result = 0;
+    mk::template_for(
+        [&](auto const& element)
+        {
+            result += element.value;
+        },
+        elements);
+    return result;
+}
+
+int
+sum_transformed_elements(void)
+{
+    auto elements = bench::make_elements(std::make_index_sequence<numElements>{ });
+    auto squares = mk::tuple_transform(
+        [](auto const& lhs, auto const& rhs)
+        {
+            return lhs.value*rhs.value;
+        },
+        elements, elements);
+    int result = 0;
+    mk::template_for(
+        [&](int square)
+        {
+            result += square;
+        },
+        squares);
+    return result;
+}
+
+
+} // namespace bench
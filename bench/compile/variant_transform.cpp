@@ -0,0 +1,60 @@
+
+// Compile-time stress test: `variant_transform()` over the product of three variants with 8, 8, and 6 alternatives.
+
+#include <cstddef>      // for size_t
+#include <utility>      // for index_sequence<>, make_index_sequence<>
+#include <variant>
+
+#include <makeshift/variant.hpp>  // for variant_transform(), visit()
+
+
+namespace bench {
+
+namespace mk = ::makeshift;
+
+
+template <int Dim, std::size_t I>
+struct Alternative
+{
+};
+
+template <int Dim, typename Is> struct make_variant_;
+template <int Dim, std::size_t... Is> struct make_variant_<Dim, std::index_sequence<Is...>> { using type = std::variant<Alternative<Dim, Is>...>; };
+template <int Dim, std::size_t N> using make_variant = typename make_variant_<Dim, std::make_index_sequence<N>>::type;
+
+using VA = make_variant<0, 8>;
+using VB = make_variant<1, 8>;
+using VC = make_variant<2, 6>;
+
+template <std::size_t I>
+struct Result
+{
+    std::size_t value;
+};
+
+struct Combine
+{
+    template <std::size_t IA, std::size_t IB, std::size_t IC>
+    Result<(IA + IB + IC) % 20>
+    operator ()(Alternative<0, IA>, Alternative<1, IB>, Alternative<2, IC>) const
+    {
+        return { IA*64 + IB*8 + IC };
+    }
+};
+
+
+std::size_t
+combine(VA const& a, VB const& b, VC const& c)
+{
+    auto result = mk::variant_transform(Combine{ }, a, b, c);
+    static_assert(std::variant_size_v<decltype(result)> == 20);
+    return mk::visit(
+        [](auto r)
+        {
+            return r.value;
+        },
+        result);
+}
+
+
+} // namespace bench
@@ -0,0 +1,106 @@
+
+// Runtime benchmarks: `apply_permutation()` and `shuffle()` compared with their standard library equivalents.
+
+#include <random>
+#include <vector>
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t
+#include <numeric>      // for iota()
+#include <algorithm>    // for shuffle(), copy(), transform()
+
+#include <makeshift/algorithm.hpp>               // for shuffle()
+#include <makeshift/experimental/algorithm.hpp>  // for apply_permutation()
+
+#include "benchmark.hpp"
+
+
+namespace {
+
+namespace mk = ::makeshift;
+
+
+constexpr std::size_t n = 1 << 16;
+
+std::vector<std::ptrdiff_t>
+make_permutation(void)
+{
+    auto result = std::vector<std::ptrdiff_t>(n);
+    std::iota(result.begin(), result.end(), std::ptrdiff_t(0));
+    std::shuffle(result.begin(), result.end(), std::mt19937_64{ 42 });
+    return result;
+}
+
+
+MAKESHIFT_BENCHMARK("permute", "gather into copy", n, numIterations)
+{
+    auto permutation = make_permutation();
+    auto values = std::vector<double>(n, 1.);
+    auto scratch = std::vector<double>(n);
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        std::transform(permutation.begin(), permutation.end(), scratch.begin(),
+            [&values](std::ptrdiff_t i)
+            {
+                return values[i];
+            });
+        std::copy(scratch.begin(), scratch.end(), values.begin());
+        bench::do_not_optimize(values.data());
+        bench::clobber_memory();
+    }
+}
+
+MAKESHIFT_BENCHMARK("permute", "apply_permutation()", n, numIterations)
+{
+        // `apply_permutation()` overwrites the index range, so it is copied in every iteration.
+    auto permutation = make_permutation();
+    auto values = std::vector<double>(n, 1.);
+    auto indices = std::vector<std::ptrdiff_t>(n);
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        std::copy(permutation.begin(), permutation.end(), indices.begin());
+        mk::apply_permutation(values.begin(), values.end(), indices.begin());
+        bench::do_not_optimize(values.data());
+        bench::clobber_memory();
+    }
+}
+
+MAKESHIFT_BENCHMARK("permute", "apply_permutation_nondestructive()", n, numIterations)
+{
+    auto permutation = make_permutation();
+    auto values = std::vector<double>(n, 1.);
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        mk::apply_permutation_nondestructive(values.begin(), values.end(), permutation.begin());
+        bench::do_not_optimize(values.data());
+        bench::clobber_memory();
+    }
+}
+
+MAKESHIFT_BENCHMARK("shuffle", "std::shuffle()", n, numIterations)
+{
+    auto values = std::vector<int>(n);
+    std::iota(values.begin(), values.end(), 0);
+    auto rng = std::mt19937_64{ 42 };
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        std::shuffle(values.begin(), values.end(), rng);
+        bench::do_not_optimize(values.data());
+        bench::clobber_memory();
+    }
+}
+
+MAKESHIFT_BENCHMARK("shuffle", "shuffle()", n, numIterations)
+{
+    auto values = std::vector<int>(n);
+    std::iota(values.begin(), values.end(), 0);
+    auto rng = std::mt19937_64{ 42 };
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        mk::shuffle(values.begin(), values.end(), rng);
+        bench::do_not_optimize(values.data());
+        bench::clobber_memory();
+    }
+}
+
+
+} // anonymous namespace
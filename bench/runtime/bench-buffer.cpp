@@ -0,0 +1,96 @@
+
+// Runtime benchmarks: `buffer<>` compared with `std::vector<>` for short-lived scratch arrays.
+
+#include <vector>
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t
+#include <type_traits>  // for integral_constant<>
+
+#include <makeshift/experimental/buffer.hpp>  // for make_buffer<>()
+
+#include "benchmark.hpp"
+
+
+namespace {
+
+namespace mk = ::makeshift;
+
+
+template <typename BufferT>
+float
+fill_and_sum(BufferT& buf)
+{
+    float x = 0.f;
+    for (auto& elem : buf)
+    {
+        elem = x;
+        x += 1.f;
+    }
+    bench::clobber_memory();
+    float sum = 0.f;
+    for (float elem : buf)
+    {
+        sum += elem;
+    }
+    return sum;
+}
+
+
+constexpr std::size_t smallSize = 16;
+constexpr std::size_t largeSize = 4096;
+
+MAKESHIFT_BENCHMARK("scratch array (16)", "std::vector<>", smallSize, numIterations)
+{
+    std::size_t size = smallSize;
+    bench::do_not_optimize(size);
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        auto buf = std::vector<float>(size);
+        bench::do_not_optimize(fill_and_sum(buf));
+    }
+}
+
+MAKESHIFT_BENCHMARK("scratch array (16)", "buffer<> (static extent)", smallSize, numIterations)
+{
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        auto buf = mk::make_buffer<float>(std::integral_constant<std::size_t, smallSize>{ });
+        bench::do_not_optimize(fill_and_sum(buf));
+    }
+}
+
+MAKESHIFT_BENCHMARK("scratch array (16)", "buffer<> (small buffer)", smallSize, numIterations)
+{
+    std::size_t size = smallSize;
+    bench::do_not_optimize(size);
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        auto buf = mk::make_buffer<float, 64>(size);
+        bench::do_not_optimize(fill_and_sum(buf));
+    }
+}
+
+MAKESHIFT_BENCHMARK("scratch array (4096)", "std::vector<>", largeSize, numIterations)
+{
+    std::size_t size = largeSize;
+    bench::do_not_optimize(size);
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        auto buf = std::vector<float>(size);
+        bench::do_not_optimize(fill_and_sum(buf));
+    }
+}
+
+MAKESHIFT_BENCHMARK("scratch array (4096)", "buffer<> (dynamic extent)", largeSize, numIterations)
+{
+    std::size_t size = largeSize;
+    bench::do_not_optimize(size);
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        auto buf = mk::make_buffer<float>(size);
+        bench::do_not_optimize(fill_and_sum(buf));
+    }
+}
+
+
+} // anonymous namespace
@@ -0,0 +1,146 @@
+
+// Runtime benchmarks: `range_for()`, `range_for_unrolled()`, and `range_zip()` compared with raw loops over vectors and `soa_span<>`.
+
+#include <array>
+#include <vector>
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t
+
+#include <gsl-lite/gsl-lite.hpp>  // for span<>, index
+
+#include <makeshift/algorithm.hpp>          // for range_for(), range_for_unrolled(), range_zip()
+#include <makeshift/experimental/span.hpp>  // for soa_span<>
+
+#include "benchmark.hpp"
+
+
+namespace {
+
+namespace mk = ::makeshift;
+namespace gsl = ::gsl_lite;
+
+
+constexpr std::size_t n = 1 << 14;
+constexpr float alpha = 1.5f;
+
+struct Vectors
+{
+    std::vector<float> x = std::vector<float>(n, 1.f);
+    std::vector<float> y = std::vector<float>(n, 2.f);
+    std::vector<float> z = std::vector<float>(n);
+};
+
+
+    // z = alpha*x + y
+MAKESHIFT_BENCHMARK("saxpy", "raw loop", n, numIterations)
+{
+    auto v = Vectors{ };
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            v.z[i] = alpha*v.x[i] + v.y[i];
+        }
+        bench::do_not_optimize(v.z.data());
+        bench::clobber_memory();
+    }
+}
+
+MAKESHIFT_BENCHMARK("saxpy", "range_for()", n, numIterations)
+{
+    auto v = Vectors{ };
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        mk::range_for(
+            [](float x, float y, float& z)
+            {
+                z = alpha*x + y;
+            },
+            v.x, v.y, v.z);
+        bench::do_not_optimize(v.z.data());
+        bench::clobber_memory();
+    }
+}
+
+MAKESHIFT_BENCHMARK("saxpy", "range_zip()", n, numIterations)
+{
+    auto v = Vectors{ };
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        for (auto&& [x, y, z] : mk::range_zip(v.x, v.y, v.z))
+        {
+            z = alpha*x + y;
+        }
+        bench::do_not_optimize(v.z.data());
+        bench::clobber_memory();
+    }
+}
+
+MAKESHIFT_BENCHMARK("saxpy", "range_for() with index", n, numIterations)
+{
+    auto v = Vectors{ };
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        mk::range_for(
+            [&v](gsl::index i, float& z)
+            {
+                z = alpha*v.x[i] + v.y[i];
+            },
+            mk::range_index, v.z);
+        bench::do_not_optimize(v.z.data());
+        bench::clobber_memory();
+    }
+}
+
+MAKESHIFT_BENCHMARK("saxpy", "soa_span<> iteration", n, numIterations)
+{
+    auto v = Vectors{ };
+    auto s = mk::soa_span(gsl::span<float>(v.x), gsl::span<float>(v.y), gsl::span<float>(v.z));
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        for (auto&& ref : s)
+        {
+            using std::get;
+            get<2>(ref) = alpha*get<0>(ref) + get<1>(ref);
+        }
+        bench::do_not_optimize(v.z.data());
+        bench::clobber_memory();
+    }
+}
+
+
+    // floating-point sum, whose serial dependency chain the compiler may not break up without -ffast-math
+MAKESHIFT_BENCHMARK("sum", "raw loop", n, numIterations)
+{
+    auto v = Vectors{ };
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        float sum = 0.f;
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            sum += v.x[i];
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+MAKESHIFT_BENCHMARK("sum", "range_for_unrolled() with 4 lanes", n, numIterations)
+{
+    auto v = Vectors{ };
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        auto partialSums = std::array<float, 4>{ };
+        mk::range_for_unrolled(
+            std::integral_constant<int, 4>{ },
+            [&partialSums](auto laneC, float x)
+            {
+                partialSums[laneC] += x;
+            },
+            v.x);
+        float sum = (partialSums[0] + partialSums[1]) + (partialSums[2] + partialSums[3]);
+        bench::do_not_optimize(sum);
+    }
+}
+
+
+} // anonymous namespace
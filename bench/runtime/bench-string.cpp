@@ -0,0 +1,196 @@
+
+// Runtime benchmarks: `parse_enum()`, `enum_to_string()`, and `flags_to_string()` compared with hand-written tables.
+
+#include <array>
+#include <string>
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t
+#include <utility>      // for pair<>
+#include <stdexcept>    // for runtime_error
+#include <string_view>
+
+#include <gsl-lite/gsl-lite.hpp>  // for type_identity<>, gsl_DEFINE_ENUM_BITMASK_OPERATORS()
+
+#include <makeshift/string.hpp>  // for parse_enum(), enum_to_string(), flags_to_string()
+
+#include "benchmark.hpp"
+
+
+namespace {
+
+namespace mk = ::makeshift;
+namespace gsl = ::gsl_lite;
+
+using namespace std::literals;
+
+
+enum class Color { red, green, blue, cyan, magenta, yellow, black, white };
+constexpr auto
+reflect(gsl::type_identity<Color>)
+{
+    return std::array{
+        std::pair{ Color::red, "red" },
+        std::pair{ Color::green, "green" },
+        std::pair{ Color::blue, "blue" },
+        std::pair{ Color::cyan, "cyan" },
+        std::pair{ Color::magenta, "magenta" },
+        std::pair{ Color::yellow, "yellow" },
+        std::pair{ Color::black, "black" },
+        std::pair{ Color::white, "white" }
+    };
+}
+
+constexpr std::array colorNames = { "red"sv, "green"sv, "blue"sv, "cyan"sv, "magenta"sv, "yellow"sv, "black"sv, "white"sv };
+
+Color
+hand_written_parse_color(std::string_view str)
+{
+    for (std::size_t i = 0; i != colorNames.size(); ++i)
+    {
+        if (colorNames[i] == str) return Color(i);
+    }
+    throw std::runtime_error("invalid color");
+}
+
+std::string
+hand_written_color_to_string(Color color)
+{
+    switch (color)
+    {
+    case Color::red: return "red";
+    case Color::green: return "green";
+    case Color::blue: return "blue";
+    case Color::cyan: return "cyan";
+    case Color::magenta: return "magenta";
+    case Color::yellow: return "yellow";
+    case Color::black: return "black";
+    case Color::white: return "white";
+    }
+    throw std::runtime_error("invalid color");
+}
+
+enum class Permissions
+{
+    none    = 0,
+    read    = 0b0001,
+    write   = 0b0010,
+    execute = 0b0100,
+    sticky  = 0b1000
+};
+gsl_DEFINE_ENUM_BITMASK_OPERATORS(Permissions)
+constexpr auto
+reflect(gsl::type_identity<Permissions>)
+{
+    return std::tuple{
+        "Permissions",
+        std::array{
+            std::pair{ Permissions::none, "none" },
+            std::pair{ Permissions::read, "read" },
+            std::pair{ Permissions::write, "write" },
+            std::pair{ Permissions::execute, "execute" },
+            std::pair{ Permissions::sticky, "sticky" }
+        }
+    };
+}
+
+std::string
+hand_written_permissions_to_string(Permissions permissions)
+{
+    static constexpr std::array names = {
+        std::pair{ Permissions::read, "read"sv },
+        std::pair{ Permissions::write, "write"sv },
+        std::pair{ Permissions::execute, "execute"sv },
+        std::pair{ Permissions::sticky, "sticky"sv }
+    };
+    if (permissions == Permissions::none) return "none";
+    auto result = std::string{ };
+    for (auto const& [flag, name] : names)
+    {
+        if ((permissions & flag) != Permissions::none)
+        {
+            if (!result.empty()) result += '+';
+            result += name;
+        }
+    }
+    return result;
+}
+
+
+MAKESHIFT_BENCHMARK("parse enum", "hand-written table", colorNames.size(), numIterations)
+{
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        for (auto name : colorNames)
+        {
+            bench::do_not_optimize(name);
+            bench::do_not_optimize(hand_written_parse_color(name));
+        }
+    }
+}
+
+MAKESHIFT_BENCHMARK("parse enum", "parse_enum()", colorNames.size(), numIterations)
+{
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        for (auto name : colorNames)
+        {
+            bench::do_not_optimize(name);
+            bench::do_not_optimize(mk::parse_enum<Color>(name));
+        }
+    }
+}
+
+MAKESHIFT_BENCHMARK("enum to string", "hand-written switch", colorNames.size(), numIterations)
+{
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        for (std::size_t i = 0; i != colorNames.size(); ++i)
+        {
+            auto color = Color(i);
+            bench::do_not_optimize(color);
+            bench::do_not_optimize(hand_written_color_to_string(color).size());
+        }
+    }
+}
+
+MAKESHIFT_BENCHMARK("enum to string", "enum_to_string()", colorNames.size(), numIterations)
+{
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        for (std::size_t i = 0; i != colorNames.size(); ++i)
+        {
+            auto color = Color(i);
+            bench::do_not_optimize(color);
+            bench::do_not_optimize(mk::enum_to_string(color).size());
+        }
+    }
+}
+
+MAKESHIFT_BENCHMARK("flags to string", "hand-written table", 16, numIterations)
+{
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        for (int i = 0; i != 16; ++i)
+        {
+            auto permissions = Permissions(i);
+            bench::do_not_optimize(permissions);
+            bench::do_not_optimize(hand_written_permissions_to_string(permissions).size());
+        }
+    }
+}
+
+MAKESHIFT_BENCHMARK("flags to string", "flags_to_string()", 16, numIterations)
+{
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        for (int i = 0; i != 16; ++i)
+        {
+            auto permissions = Permissions(i);
+            bench::do_not_optimize(permissions);
+            bench::do_not_optimize(mk::flags_to_string(permissions).size());
+        }
+    }
+}
+
+
+} // anonymous namespace
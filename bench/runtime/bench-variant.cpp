@@ -0,0 +1,132 @@
+
+// Runtime benchmarks: `expand()` and `visit()` compared with a hand-written switch.
+
+#include <array>
+#include <random>
+#include <vector>
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t
+#include <variant>
+
+#include <makeshift/constval.hpp>  // for MAKESHIFT_CONSTVAL()
+#include <makeshift/variant.hpp>   // for expand(), expand_compact(), visit()
+
+#include "benchmark.hpp"
+
+
+namespace {
+
+namespace mk = ::makeshift;
+
+
+constexpr std::size_t n = 4096;
+
+    // Runtime values of a parameter which is dispatched to compile-time specializations.
+std::vector<int>
+make_widths(void)
+{
+    auto rng = std::mt19937{ 42 };
+    auto dist = std::uniform_int_distribution<int>{ 0, 3 };
+    auto result = std::vector<int>(n);
+    for (int& width : result)
+    {
+        width = 1 << dist(rng);
+    }
+    return result;
+}
+
+template <int Width>
+int
+kernel(int x)
+{
+    int result = x;
+    for (int i = 0; i != Width; ++i)
+    {
+        result = result*3 + i;
+    }
+    return result;
+}
+
+
+MAKESHIFT_BENCHMARK("dispatch", "switch", n, numIterations)
+{
+    auto widths = make_widths();
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        int sum = 0;
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            switch (widths[i])
+            {
+            case 1: sum += kernel<1>(int(i)); break;
+            case 2: sum += kernel<2>(int(i)); break;
+            case 4: sum += kernel<4>(int(i)); break;
+            case 8: sum += kernel<8>(int(i)); break;
+            }
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+MAKESHIFT_BENCHMARK("dispatch", "expand() + std::visit()", n, numIterations)
+{
+    auto widths = make_widths();
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        int sum = 0;
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            auto widthV = mk::expand(widths[i], MAKESHIFT_CONSTVAL(std::array{ 1, 2, 4, 8 }));
+            sum += std::visit(
+                [x = int(i)](auto widthC)
+                {
+                    return kernel<decltype(widthC)::value>(x);
+                },
+                widthV);
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+MAKESHIFT_BENCHMARK("dispatch", "expand() + visit()", n, numIterations)
+{
+    auto widths = make_widths();
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        int sum = 0;
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            auto widthV = mk::expand(widths[i], MAKESHIFT_CONSTVAL(std::array{ 1, 2, 4, 8 }));
+            sum += mk::visit(
+                [x = int(i)](auto widthC)
+                {
+                    return kernel<decltype(widthC)::value>(x);
+                },
+                widthV);
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+MAKESHIFT_BENCHMARK("dispatch", "expand_compact() + visit()", n, numIterations)
+{
+    auto widths = make_widths();
+    for (std::int64_t it = 0; it != numIterations; ++it)
+    {
+        int sum = 0;
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            auto widthV = mk::expand_compact(widths[i], MAKESHIFT_CONSTVAL(std::array{ 1, 2, 4, 8 }));
+            sum += mk::visit(
+                [x = int(i)](auto widthC)
+                {
+                    return kernel<decltype(widthC)::value>(x);
+                },
+                widthV);
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+
+} // anonymous namespace
@@ -0,0 +1,185 @@
+
+// Runner for the makeshift runtime benchmarks.
+//
+// usage: bench-makeshift [--filter <substring>] [--min-time <seconds>] [--samples <count>] [--json <file>]
+//
+// Prints a table of results to stdout. With `--json`, results are also written to the given file in a machine-readable format
+// suitable for tracking performance across releases.
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>       // for printf(), fprintf()
+#include <cstdint>      // for int64_t
+#include <cstdlib>      // for strtod(), strtol()
+#include <fstream>
+#include <ostream>
+#include <cstring>      // for strcmp()
+#include <algorithm>    // for sort(), max()
+#include <string_view>
+
+#include "benchmark.hpp"
+
+
+#ifndef MAKESHIFT_BENCH_VERSION
+# define MAKESHIFT_BENCH_VERSION "unknown"
+#endif // MAKESHIFT_BENCH_VERSION
+
+
+namespace bench {
+
+namespace {
+
+
+std::vector<benchmark>&
+registered_benchmarks(void)
+{
+    static auto benchmarks = std::vector<benchmark>{ };
+    return benchmarks;
+}
+
+struct result
+{
+    benchmark const* b;
+    std::int64_t numIterations;
+    double nsPerIteration;
+    double baselineNsPerIteration;
+};
+
+double
+measure_seconds(benchmark const& b, std::int64_t numIterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    b.run(numIterations);
+    bench::clobber_memory();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+result
+run_benchmark(benchmark const& b, double minTime, int numSamples)
+{
+        // Determine the number of iterations such that every sample takes at least `minTime` seconds.
+    std::int64_t numIterations = 1;
+    double elapsed = bench::measure_seconds(b, numIterations);
+    while (elapsed < minTime)
+    {
+        double factor = elapsed > 0 ? std::min(minTime*1.2/elapsed, 10.) : 10.;
+        numIterations = std::max(numIterations + 1, std::int64_t(double(numIterations)*factor));
+        elapsed = bench::measure_seconds(b, numIterations);
+    }
+
+        // Report the median of the samples, which is less sensitive to interference than the mean.
+    auto samples = std::vector<double>{ };
+    for (int i = 0; i != numSamples; ++i)
+    {
+        samples.push_back(bench::measure_seconds(b, numIterations)/double(numIterations));
+    }
+    std::sort(samples.begin(), samples.end());
+    double median = samples[samples.size()/2]*1.e9;
+    return { &b, numIterations, median, median };
+}
+
+std::string
+json_escape(std::string_view str)
+{
+    auto result = std::string{ };
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\') result += '\\';
+        result += c;
+    }
+    return result;
+}
+
+void
+write_json(std::ostream& stream, std::vector<result> const& results)
+{
+    stream << "{\n"
+           << "  \"version\": \"" << json_escape(MAKESHIFT_BENCH_VERSION) << "\",\n"
+           << "  \"benchmarks\": [";
+    char const* separator = "\n";
+    for (auto const& r : results)
+    {
+        stream << separator
+               << "    { \"group\": \"" << json_escape(r.b->group) << "\", \"name\": \"" << json_escape(r.b->name) << "\""
+               << ", \"iterations\": " << r.numIterations
+               << ", \"ns_per_iteration\": " << r.nsPerIteration
+               << ", \"ns_per_item\": " << r.nsPerIteration/double(r.b->itemsPerIteration)
+               << ", \"relative_to_baseline\": " << r.nsPerIteration/r.baselineNsPerIteration << " }";
+        separator = ",\n";
+    }
+    stream << "\n  ]\n}\n";
+}
+
+int
+usage(char const* program)
+{
+    std::fprintf(stderr, "usage: %s [--filter <substring>] [--min-time <seconds>] [--samples <count>] [--json <file>]\n", program);
+    return 2;
+}
+
+
+} // anonymous namespace
+
+
+void
+register_benchmark(benchmark const& b)
+{
+    bench::registered_benchmarks().push_back(b);
+}
+
+
+} // namespace bench
+
+
+int
+main(int argc, char* argv[])
+{
+    auto filter = std::string_view{ };
+    double minTime = 0.05;
+    int numSamples = 5;
+    char const* jsonPath = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (i + 1 == argc) return bench::usage(argv[0]);
+        if (std::strcmp(argv[i], "--filter") == 0) filter = argv[++i];
+        else if (std::strcmp(argv[i], "--min-time") == 0) minTime = std::strtod(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--samples") == 0) numSamples = int(std::strtol(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--json") == 0) jsonPath = argv[++i];
+        else return bench::usage(argv[0]);
+    }
+    if (minTime <= 0 || numSamples <= 0) return bench::usage(argv[0]);
+
+    auto results = std::vector<bench::result>{ };
+    std::printf("%-24s %-36s %14s %12s %10s\n", "group", "name", "ns/iteration", "ns/item", "relative");
+    for (auto const& b : bench::registered_benchmarks())
+    {
+        auto fullName = std::string(b.group) + '/' + b.name;
+        if (fullName.find(filter) == std::string::npos) continue;
+
+        auto r = bench::run_benchmark(b, minTime, numSamples);
+        auto baseline = std::find_if(results.begin(), results.end(),
+            [&](bench::result const& other)
+            {
+                return std::string_view(other.b->group) == b.group;
+            });
+        if (baseline != results.end()) r.baselineNsPerIteration = baseline->nsPerIteration;
+        results.push_back(r);
+        std::printf("%-24s %-36s %14.1f %12.3f %9.2fx\n", b.group, b.name,
+            r.nsPerIteration, r.nsPerIteration/double(b.itemsPerIteration), r.nsPerIteration/r.baselineNsPerIteration);
+        std::fflush(stdout);
+    }
+
+    if (jsonPath != nullptr)
+    {
+        auto stream = std::ofstream(jsonPath);
+        bench::write_json(stream, results);
+        if (!stream)
+        {
+            std::fprintf(stderr, "error: could not write results to '%s'\n", jsonPath);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+﻿
+// Minimal timing harness for the makeshift runtime benchmarks.
+
+#ifndef INCLUDED_MAKESHIFT_BENCH_BENCHMARK_HPP_
+#define INCLUDED_MAKESHIFT_BENCH_BENCHMARK_HPP_
+
+
+#include <atomic>       // for atomic_signal_fence()
+#include <cstdint>      // for int64_t
+
+
+namespace bench {
+
+
+    //
+    // A benchmark runs a piece of code `numIterations` times. Benchmarks with the same group name are alternative
+    // implementations of the same task; the first benchmark registered in a group is the baseline the others are compared to.
+    //
+struct benchmark
+{
+    char const* group;
+    char const* name;
+    std::int64_t itemsPerIteration;
+    void (*run)(std::int64_t numIterations);
+};
+
+void register_benchmark(benchmark const& b);
+
+struct benchmark_registrar
+{
+    explicit benchmark_registrar(benchmark const& b)
+    {
+        bench::register_benchmark(b);
+    }
+};
+
+
+    //
+    // Prevents the compiler from optimizing away the computation of the given value.
+    //
+template <typename T>
+inline void
+do_not_optimize(T const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile char sink;
+    sink = *reinterpret_cast<char const volatile*>(&value);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+    //
+    // Prevents the compiler from assuming that memory is unchanged across this point, or from eliding preceding stores.
+    //
+inline void
+clobber_memory(void)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+
+} // namespace bench
+
+
+#define MAKESHIFT_BENCH_CAT_0_(A, B) A##B
+#define MAKESHIFT_BENCH_CAT_(A, B) MAKESHIFT_BENCH_CAT_0_(A, B)
+
+    //
+    // Defines and registers a benchmark. The body runs the benchmarked code `numIterations` times.
+    //ᅟ
+    //ᅟ    MAKESHIFT_BENCHMARK("saxpy", "raw loop", n, numIterations)
+    //ᅟ    {
+    //ᅟ        for (std::int64_t it = 0; it != numIterations; ++it) { ... }
+    //ᅟ    }
+    //
+#define MAKESHIFT_BENCHMARK(GROUP, NAME, ITEMS_PER_ITERATION, NUM_ITERATIONS) \
+    static void MAKESHIFT_BENCH_CAT_(makeshift_benchmark_, __LINE__)(std::int64_t NUM_ITERATIONS); \
+    static ::bench::benchmark_registrar const MAKESHIFT_BENCH_CAT_(makeshift_benchmark_registrar_, __LINE__){ \
+        ::bench::benchmark{ GROUP, NAME, ITEMS_PER_ITERATION, &MAKESHIFT_BENCH_CAT_(makeshift_benchmark_, __LINE__) } }; \
+    static void MAKESHIFT_BENCH_CAT_(makeshift_benchmark_, __LINE__)(std::int64_t NUM_ITERATIONS)
+
+
+#endif // INCLUDED_MAKESHIFT_BENCH_BENCHMARK_HPP_
@@ -5,8 +5,9 @@
 
 #include <cstddef>      // for ptrdiff_t
 #include <utility>      // for forward<>(), swap()
+#include <random>       // for uniform_int_distribution<>
 #include <iterator>     // for iterator_traits<>
-#include <type_traits>  // for integral_constant<>, decay<>, conjunction<>
+#include <type_traits>  // for integral_constant<>, decay<>, conjunction<>, is_same<>, remove_cv<>, is_member_object_pointer<>
 
 #include <gsl-lite/gsl-lite.hpp>  // for index, gsl_Expects(), gsl_CPP20_OR_GREATER
 
@@ -52,6 +53,32 @@ shuffle(RandomIt first, RandomIt last, URBG&& rng, UniformIntDistributionT dist)
     }
 }
 
+    //
+    // Similar to `std::shuffle()`, but supports iterators with proxy reference types such as `std::vector<bool>` or `soa_span<>`
+    // (which cannot implement LegacyRandomAccessIterator even though they may be random-access).
+    // If the random bit generator produces uniformly distributed 32-bit or 64-bit words (as do `std::mt19937` and
+    // `std::mt19937_64`), random indices are generated with Lemire's nearly divisionless method, and two indices are drawn from
+    // every 64-bit word. The resulting permutation thus differs from the permutation generated by `std::shuffle()`.
+    //ᅟ
+    //ᅟ    shuffle(v.begin(), v.end(), rng);
+    //
+template <typename RandomIt, typename URBG>
+constexpr void
+shuffle(RandomIt first, RandomIt last, URBG&& rng)
+{
+    using Diff = typename std::iterator_traits<RandomIt>::difference_type;
+
+    if constexpr (detail::is_full_range_urbg_<URBG>::value)
+    {
+        Diff length = last - first;
+        detail::shuffle_batched(first, std::ptrdiff_t(length), rng);
+    }
+    else
+    {
+        makeshift::shuffle(first, last, rng, std::uniform_int_distribution<Diff>{ });
+    }
+}
+
 
     //
     // Given a list of ranges, returns a range of tuples. 
@@ -75,6 +102,106 @@ range_zip(Rs&&... ranges)
 }
 
 
+    //
+    // Given a function and a list of ranges, returns a lazy range of the results of the function applied to the sets of range
+    // elements. When passed to `range_zip()`, `range_for()`, or other `range_*()` algorithms, the transformation is fused into
+    // the loop of the algorithm. If none of the ranges has a known size (e.g. `std::forward_list<>`), the range returns a
+    // sentinel as end iterator.
+    //ᅟ
+    //ᅟ    auto squares = range_transform([](int x) { return x*x; }, std::array{ 1, 2, 3 });
+    //ᅟ    range_for(
+    //ᅟ        [](gsl::index i, int sq) { std::cout << "square[" << i << "]: " << sq << '\n'; },
+    //ᅟ        range_index, squares);
+    //ᅟ    // prints "square[0]: 1\nsquare[1]: 4\nsquare[2]: 9\n"
+    //
+template <typename F, typename... Rs>
+[[nodiscard]] constexpr auto
+range_transform(F&& func, Rs&&... ranges)
+{
+    static_assert(sizeof...(Rs) > 0, "no range argument given");
+
+    auto mergedSize = detail::merge_sizes(detail::range_size(ranges)...);
+    return detail::make_transform_range(mergedSize, std::forward<F>(func), std::forward<Rs>(ranges)...);
+}
+
+
+    //
+    // Given a range of indices and a random-access data range, returns a lazy range of the data elements referred to by the
+    // indices. Elements are accessed by reference, so the range can be used both for gathering and for scattering.
+    //ᅟ
+    //ᅟ    auto values = std::array{ 10, 20, 30, 40 };
+    //ᅟ    auto indices = std::array{ 3, 1, 2 };
+    //ᅟ    range_for(
+    //ᅟ        [](gsl::index i, int v) { std::cout << "value[" << i << "]: " << v << '\n'; },
+    //ᅟ        range_index, indirect_range(indices, values));
+    //ᅟ    // prints "value[0]: 40\nvalue[1]: 20\nvalue[2]: 30\n"
+    //
+template <typename IndexR, typename DataR>
+[[nodiscard]] constexpr auto
+indirect_range(IndexR&& indices, DataR&& data)
+{
+    return detail::make_indirect_range<0>(std::forward<IndexR>(indices), std::forward<DataR>(data));
+}
+
+    //
+    // Given a range of indices, a random-access data range, and a constval prefetch distance `d`, returns a lazy range of the
+    // data elements referred to by the indices. When the element at position `i` is accessed, the data element referred to by
+    // the index at position `i + d` is prefetched. The index range must support random access.
+    //ᅟ
+    //ᅟ    range_for(
+    //ᅟ        [](double& x) { x *= 2; },
+    //ᅟ        indirect_range(selection, values, std::integral_constant<std::ptrdiff_t, 16>{ }));
+    //
+template <typename IndexR, typename DataR, typename PrefetchDistanceC>
+[[nodiscard]] constexpr auto
+indirect_range(IndexR&& indices, DataR&& data, PrefetchDistanceC)
+{
+    static_assert(PrefetchDistanceC::value >= 0, "prefetch distance must be non-negative");
+    static_assert(PrefetchDistanceC::value == 0 || std::is_base_of<std::random_access_iterator_tag, detail::range_iterator_category_t<std::decay_t<IndexR>>>::value,
+        "prefetching requires a random-access index range");
+
+    return detail::make_indirect_range<std::ptrdiff_t(PrefetchDistanceC::value)>(std::forward<IndexR>(indices), std::forward<DataR>(data));
+}
+
+
+    //
+    // Returns a range of `count` elements at `data[0]`, `data[stride]`, `data[2*stride]`, etc. The count and the stride can be
+    // runtime values or constvals. When passed to `range_zip()`, `range_for()`, or other `range_*()` algorithms, elements are
+    // addressed by index and stride. The stride counts elements of the array `data` points into, e.g. a column of a row-major
+    // matrix; to view a field of an array of structures, pass a pointer to the data member instead (see below).
+    //ᅟ
+    //ᅟ    auto matrix = std::vector<double>(rows*cols);  // row-major
+    //ᅟ    auto column = strided_range(matrix.data() + j, rows, cols);
+    //ᅟ    range_for(
+    //ᅟ        [](double& x, double v) { x += v; },
+    //ᅟ        column, values);
+    //
+template <typename T, typename C, typename S>
+[[nodiscard]] constexpr auto
+strided_range(T* data, C count, S stride)
+{
+    return detail::make_strided_range(data, count, stride);
+}
+
+    //
+    // Returns a range of the data members `data[0].*member`, `data[1].*member`, ..., `data[count-1].*member`, e.g. a field of an
+    // array of structures. The count can be a runtime value or a constval.
+    //ᅟ
+    //ᅟ    struct Point { double x, y, z; };
+    //ᅟ    auto points = std::vector<Point>(n);
+    //ᅟ    range_fill(strided_range(points.data(), &Point::y, n), 0.);
+    //
+template <typename T, typename M, typename U, typename C>
+[[nodiscard]] constexpr auto
+strided_range(T* data, M U::* member, C count)
+{
+    static_assert(std::is_same<std::remove_cv_t<T>, U>::value, "member must belong to the element type");
+    static_assert(std::is_member_object_pointer<M U::*>::value, "member must be a data member");
+
+    return detail::make_strided_range(data, count, std::integral_constant<gsl::stride, 1>{ }, member);
+}
+
+
 // TODO: define iota_view(), sub_view()
 
 
@@ -102,52 +229,80 @@ range_for(F&& func, Rs&&... ranges)
     }
 }
 
+    //
+    // Takes a constval unroll factor `u`, a scalar procedure, and a list of random-access ranges, and calls the procedure for
+    // every set of elements in the ranges. The loop body is unrolled `u` times, which permits the compiler to interleave
+    // independent iterations; the remaining elements are processed one by one. If the procedure accepts a constval lane index
+    // in [0, u) as its first argument, the index is passed as an argument of type `integral_constant<index, I>`.
+    //ᅟ
+    //ᅟ    auto partialSums = std::array<double, 4>{ };
+    //ᅟ    range_for_unrolled(
+    //ᅟ        std::integral_constant<int, 4>{ },
+    //ᅟ        [&](auto laneC, double x) { partialSums[laneC] += x; },
+    //ᅟ        values);
+    //ᅟ    double sum = (partialSums[0] + partialSums[1]) + (partialSums[2] + partialSums[3]);
+    //
+template <typename UnrollC, typename F, typename... Rs>
+constexpr void
+range_for_unrolled(UnrollC, F&& func, Rs&&... ranges)
+{
+    constexpr gsl::dim unroll = UnrollC::value;
+    static_assert(unroll >= 1, "unroll factor must be positive");
+    static_assert(!std::conjunction_v<std::is_same<std::decay_t<Rs>, detail::range_index_t>...>, "no range argument given");
+    static_assert(std::is_base_of<std::random_access_iterator_tag, detail::common_iterator_tag<detail::range_iterator_concept_t<std::decay_t<Rs>>...>>::value,
+        "range_for_unrolled() requires random-access ranges");
+
+    auto mergedSize = detail::merge_sizes(detail::range_size(ranges)...);
+    static_assert(!std::is_same<decltype(mergedSize), detail::dim_constant<detail::unknown_size>>::value, "cannot infer the number of elements");
+
+    auto size = gsl::dim(mergedSize);
+    auto it = detail::make_zip_begin_iterator(mergedSize, ranges...);
+    gsl::dim numGroups = size/unroll;
+    for (gsl::dim g = 0; g != numGroups; ++g)
+    {
+        detail::apply_lanes(std::make_index_sequence<std::size_t(unroll)>{ }, func, it);
+        it += unroll;
+    }
+    if constexpr (unroll > 1)
+    {
+        detail::apply_remainder_lanes(std::make_index_sequence<std::size_t(unroll - 1)>{ }, func, it, size - numGroups*unroll);
+    }
+}
+
 
     //
     // Fills the range with sequentially increasing values, starting with `value` and repetitively evaluating `++value`.
+    // Contiguous ranges of arithmetic type which are too large to fit into the cache are filled with non-temporal stores.
     //
 template <typename R, typename T>
 constexpr void
 range_iota(R&& range, T value)
 {
-    auto it = detail::range_begin(range);
-    auto end = detail::range_end(range);
-    for (; it != end; ++it)
-    {
-        *it = value++;
-    }
+    detail::store_sequence(range, [&value]() -> T { return value++; });
 }
 
 
     //
-    // Fills the range with the given value.
+    // Fills the range with the given value. Contiguous ranges of arithmetic type which are too large to fit into the cache are
+    // filled with non-temporal stores.
     //
 template <typename R, typename T>
 constexpr void
 range_fill(R&& range, T const& value)
 {
-    auto it = detail::range_begin(range);
-    auto end = detail::range_end(range);
-    for (; it != end; ++it)
-    {
-        *it = value;
-    }
+    detail::store_sequence(range, [&value]() -> T const& { return value; });
 }
 
 
     //
-    // Fills the range with the values generated by the given functor.
+    // Fills the range with the values generated by the given functor. Contiguous ranges of arithmetic type which are too large
+    // to fit into the cache are filled with non-temporal stores.
     //
 template <typename R, typename F>
 constexpr void
 range_generate(R&& range, F const& generate)
 {
-    auto it = detail::range_begin(range);
-    auto end = detail::range_end(range);
-    for (; it != end; ++it)
-    {
-        *it = generate();
-    }
+    detail::store_sequence(range, [&generate]() -> decltype(auto) { return generate(); });
 }
 
 
@@ -179,6 +334,81 @@ range_transform_reduce(T&& initialValue, ReduceFuncT&& reduce, TransformFuncT&&
 }
 
 
+    //
+    // Takes an initial value, a reducer, a transformer, an output range, and a list of input ranges, and stores the inclusive
+    // prefix reductions of the transformed input elements in the output range. Returns the total reduction.
+    // The output range may alias one of the input ranges.
+    //ᅟ
+    //ᅟ    auto offsets = std::array<int, 3>{ };
+    //ᅟ    range_inclusive_scan(
+    //ᅟ        0,
+    //ᅟ        std::plus<>{ },
+    //ᅟ        [](auto&& str) { return int(str.length()); },
+    //ᅟ        offsets,
+    //ᅟ        std::array{ "Hello"sv, ", "sv, "World!"sv });
+    //ᅟ    // returns 13; `offsets` now holds { 5, 7, 13 }
+    //
+template <typename T, typename ReduceFuncT, typename TransformFuncT, typename OutputR, typename... Rs>
+constexpr std::decay_t<T>
+range_inclusive_scan(T&& initialValue, ReduceFuncT&& reduce, TransformFuncT&& transform, OutputR&& output, Rs&&... ranges)
+{
+    static_assert(sizeof...(Rs) != 0, "no input range given");
+
+    auto mergedSize = detail::merge_sizes(detail::range_size(output), detail::range_size(ranges)...);
+    std::decay_t<T> result = std::forward<T>(initialValue);
+    auto it = detail::make_zip_begin_iterator(mergedSize, output, ranges...);
+    auto end = detail::make_zip_iterator_sentinel(mergedSize);
+    for (; it != end; ++it)
+    {
+        it.apply(
+            [&](auto&& dst, auto&&... elems)
+            {
+                result = reduce(std::move(result), transform(std::forward<decltype(elems)>(elems)...));
+                dst = result;
+            });
+    }
+    return result;
+}
+
+
+    //
+    // Takes an initial value, a reducer, a transformer, an output range, and a list of input ranges, and stores the exclusive
+    // prefix reductions of the transformed input elements in the output range. Returns the total reduction.
+    // The output range may alias one of the input ranges.
+    //ᅟ
+    //ᅟ    auto offsets = std::array<int, 3>{ };
+    //ᅟ    range_exclusive_scan(
+    //ᅟ        0,
+    //ᅟ        std::plus<>{ },
+    //ᅟ        [](auto&& str) { return int(str.length()); },
+    //ᅟ        offsets,
+    //ᅟ        std::array{ "Hello"sv, ", "sv, "World!"sv });
+    //ᅟ    // returns 13; `offsets` now holds { 0, 5, 7 }
+    //
+template <typename T, typename ReduceFuncT, typename TransformFuncT, typename OutputR, typename... Rs>
+constexpr std::decay_t<T>
+range_exclusive_scan(T&& initialValue, ReduceFuncT&& reduce, TransformFuncT&& transform, OutputR&& output, Rs&&... ranges)
+{
+    static_assert(sizeof...(Rs) != 0, "no input range given");
+
+    auto mergedSize = detail::merge_sizes(detail::range_size(output), detail::range_size(ranges)...);
+    std::decay_t<T> result = std::forward<T>(initialValue);
+    auto it = detail::make_zip_begin_iterator(mergedSize, output, ranges...);
+    auto end = detail::make_zip_iterator_sentinel(mergedSize);
+    for (; it != end; ++it)
+    {
+        it.apply(
+            [&](auto&& dst, auto&&... elems)
+            {
+                    // Transform the input elements first in case the output range aliases an input range.
+                auto value = transform(std::forward<decltype(elems)>(elems)...);
+                dst = result;
+                result = reduce(std::move(result), std::move(value));
+            });
+    }
+    return result;
+}
+
     //
     // Takes an initial value, a reducer, and a range and reduces it to a scalar value.
     //ᅟ
@@ -229,6 +459,102 @@ range_count_if(PredicateT&& predicate, Rs&&... ranges)
 }
 
 
+    //
+    // Takes a predicate, an output range, and a list of input ranges, copies the sets of input elements for which the predicate
+    // applies to the output range, and returns the number of elements copied. If more than one input range is given, the
+    // elements of the output range must be tuple-like (e.g. a zipped range or a `soa_span<>`). The output range must be large
+    // enough to hold all elements copied and must not overlap the input ranges. If the output range is random-access, has
+    // trivially copyable elements, and is at least as large as the input ranges, a branchless kernel is used. Unlike
+    // `std::copy_if()`, the branchless kernel may overwrite the output element following the last element copied with a set of
+    // input elements for which the predicate does not apply.
+    //ᅟ
+    //ᅟ    auto values = std::array{ 1, -2, 3 };
+    //ᅟ    auto indices = std::array<gsl::index, 3>{ };
+    //ᅟ    auto positives = std::array<int, 3>{ };
+    //ᅟ    range_copy_if(
+    //ᅟ        [](gsl::index, int v) { return v > 0; },
+    //ᅟ        range_zip(indices, positives),
+    //ᅟ        range_index, values);
+    //ᅟ    // returns 2; `indices` and `positives` now start with { 0, 2 } and { 1, 3 }, respectively
+    //
+template <typename PredicateT, typename OutputR, typename... Rs>
+constexpr std::ptrdiff_t
+range_copy_if(PredicateT&& predicate, OutputR&& output, Rs&&... ranges)
+{
+    static_assert(!std::conjunction_v<std::is_same<std::decay_t<Rs>, detail::range_index_t>...>, "no input range given");
+
+    auto outputSize = detail::range_size(output);
+    auto mergedSize = detail::merge_sizes(detail::range_size(ranges)...);
+    static_assert(!std::is_same<decltype(outputSize), detail::dim_constant<detail::unknown_size>>::value, "size of output range cannot be inferred");
+    auto out = detail::make_zip_begin_iterator(outputSize, output);
+    auto it = detail::make_zip_begin_iterator(mergedSize, ranges...);
+    auto end = detail::make_zip_iterator_sentinel(mergedSize);
+    if constexpr (detail::ranges_permit_branchless_compaction_<OutputR>::value)
+    {
+        if (gsl::dim(mergedSize) != detail::unknown_size && gsl::dim(outputSize) >= gsl::dim(mergedSize))
+        {
+            return detail::copy_if_block<true>(predicate, out, outputSize, it, end);
+        }
+    }
+    return detail::copy_if_block<false>(predicate, out, outputSize, it, end);
+}
+
+
+    //
+    // Takes a predicate and a list of ranges, removes the sets of range elements for which the predicate applies by moving the
+    // remaining elements to the front of the ranges, and returns the number of remaining elements. The elements following the
+    // remaining elements are left in a valid but unspecified state. If all ranges are random-access and have trivially
+    // copyable elements, a branchless kernel is used.
+    //ᅟ
+    //ᅟ    auto positions = std::vector{ 0.5, 1.5, -0.5 };
+    //ᅟ    auto velocities = std::vector{ 1., 2., 3. };
+    //ᅟ    auto n = range_remove_if(
+    //ᅟ        [](double x, double) { return x < 0 || x > 1; },
+    //ᅟ        positions, velocities);
+    //ᅟ    positions.resize(n);
+    //ᅟ    velocities.resize(n);
+    //ᅟ    // `positions` and `velocities` now hold { 0.5 } and { 1. }, respectively
+    //
+template <typename PredicateT, typename... Rs>
+constexpr std::ptrdiff_t
+range_remove_if(PredicateT&& predicate, Rs&&... ranges)
+{
+    static_assert(!std::conjunction_v<std::is_same<std::decay_t<Rs>, detail::range_index_t>...>, "no range argument given");
+
+    auto mergedSize = detail::merge_sizes(detail::range_size(ranges)...);
+    auto dst = detail::make_zip_begin_iterator(mergedSize, ranges...);
+    auto it = dst;
+    auto end = detail::make_zip_iterator_sentinel(mergedSize);
+    auto result = std::ptrdiff_t(0);
+    if constexpr (detail::ranges_permit_branchless_compaction_<Rs...>::value)
+    {
+        for (; it != end; ++it)
+        {
+            bool keep = !it.apply(predicate);
+            detail::move_elements(dst, it);
+            dst += std::ptrdiff_t(keep);
+            result += std::ptrdiff_t(keep);
+        }
+    }
+    else
+    {
+        for (gsl::index i = 0; it != end; ++i, ++it)
+        {
+            if (!it.apply(predicate))
+            {
+                if (result != i)
+                {
+                    detail::move_elements(dst, it);
+                }
+                ++dst;
+                ++result;
+            }
+        }
+    }
+    return result;
+}
+
+
     //
     // Takes a predicate and a list of ranges and returns whether the predicate is satisfied for all sets of range elements.
     //ᅟ
@@ -304,6 +630,32 @@ range_none_of(PredicateT&& predicate, Rs&&... ranges)
 }
 
 
+    //
+    // Takes a predicate and a list of ranges and returns the index of the first set of range elements for which the predicate
+    // is satisfied, or -1 if there is no such set.
+    //ᅟ
+    //ᅟ    range_find_if(
+    //ᅟ        [](auto&& str) { return str.empty(); },
+    //ᅟ        std::array{ "Hello, "sv, ""sv, "World!"sv });
+    //ᅟ    // returns 1
+    //
+template <typename PredicateT, typename... Rs>
+[[nodiscard]] constexpr gsl::index
+range_find_if(PredicateT&& predicate, Rs&&... ranges)
+{
+    static_assert(!std::conjunction_v<std::is_same<std::decay_t<Rs>, detail::range_index_t>...>, "no range argument given");
+
+    auto mergedSize = detail::merge_sizes(detail::range_size(ranges)...);
+    auto it = detail::make_zip_begin_iterator(mergedSize, ranges...);
+    auto end = detail::make_zip_iterator_sentinel(mergedSize);
+    for (gsl::index i = 0; it != end; ++i, ++it)
+    {
+        if (it.apply(predicate)) return i;
+    }
+    return -1;
+}
+
+
 } // namespace makeshift
 
 
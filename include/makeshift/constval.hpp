@@ -257,19 +257,29 @@ constval_extend(const CF&, const Cs&... args)
 
     //
     // Converts the given constval, taken to be a range of elements, to a `std::array<>`. Useful to convert dynamic compile-time
-    // computations into `constinit` data.
-    // TODO: we do not support proper constvals here yet.
+    // computations into `constinit` data. If the argument is a proto-constval such as a lambda, the array is returned as a
+    // value; if it is a constval, the array is returned as a constval, which can then be used e.g. as a set of values for
+    // `expand()`.
     //ᅟ
     //ᅟ    auto dataC = [] { return std::vector{ 1, 2, 3 }; };
     //ᅟ    constexpr std::array<int, 3> data = constval_range_to_array(dataC);  // returns `std::array{ 1, 2, 3 }`
+    //ᅟ
+    //ᅟ    auto primesC = constval_range_to_array(MAKESHIFT_CONSTVAL(50), [](int n) { return computePrimesUpTo(n); });
+    //ᅟ    // returns `array_constant<int, 2, 3, 5, ..., 47>{ }`
     //
 template <typename C, typename ProjT = gsl::identity>
 [[nodiscard]] constexpr auto
 constval_range_to_array(C, ProjT = { })
 {
     static_assert(is_type_transportable_v<ProjT>, "projector must be type-transportable");
-    constexpr std::size_t N = std::size(ProjT{ }(C{ }()));
-    return detail::constval_range_to_array_impl<N>(ProjT{ }(C{ }()));
+    if constexpr (is_constval_v<C>)
+    {
+        return constval_t<detail::constval_range_to_array_functor<C, ProjT>>{ };
+    }
+    else
+    {
+        return detail::constval_range_to_array_functor<C, ProjT>{ }();
+    }
 }
 
 
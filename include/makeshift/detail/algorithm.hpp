@@ -4,16 +4,23 @@
 
 
 #include <cstddef>      // for size_t, ptrdiff_t
+#include <cstdint>      // for uint64_t, uintptr_t
 #include <tuple>
-#include <utility>      // for forward<>(), integer_sequence<>
-#include <type_traits>  // for integral_constant<>, declval<>(), decay<>
+#include <memory>       // for addressof()
+#include <utility>      // for forward<>(), move(), integer_sequence<>
+#include <iterator>     // for iterator_traits<>, random_access_iterator_tag
+#include <type_traits>  // for integral_constant<>, declval<>(), decay<>, is_trivially_copyable<>, conjunction<>, is_arithmetic<>, is_constant_evaluated()
 
-#include <gsl-lite/gsl-lite.hpp>  // for dim, index
+#include <gsl-lite/gsl-lite.hpp>  // for dim, index, gsl_Expects(), gsl_ExpectsAudit()
 
-#include <makeshift/detail/macros.hpp>  // for MAKESHIFT_DETAIL_EMPTY_BASES, MAKESHIFT_DETAIL_FORCEINLINE
+#include <makeshift/detail/macros.hpp>  // for MAKESHIFT_DETAIL_EMPTY_BASES, MAKESHIFT_DETAIL_FORCEINLINE, MAKESHIFT_DETAIL_PREFETCH, MAKESHIFT_DETAIL_SSE2
 #include <makeshift/detail/ranges.hpp>  // for range_index_t
 #include <makeshift/detail/zip.hpp>
 
+#if MAKESHIFT_DETAIL_SSE2
+# include <emmintrin.h>  // for __m128i, _mm_load_si128(), _mm_stream_si128(), _mm_sfence()
+#endif // MAKESHIFT_DETAIL_SSE2
+
 
 namespace makeshift {
 
@@ -142,15 +149,46 @@ public:
         (void) Swallow{ 1, (detail::get_leaf<Is>(*this)._check_end(isEnd), 0)... };
     }
 
+        // for leaves which embed a zip iterator: advance the leaves but not the index, which is tracked by the enclosing iterator;
+        // check for the end with the leaves if the size is unknown
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr auto _is_end_leaves(void) const
+    {
+        return _is_end();
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr void _inc_leaves(void)
+    {
+        using Swallow = int[];
+        (void) Swallow{ 1, (detail::get_leaf<Is>(*this)._inc(), void(), int{ })... };
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr void _dec_leaves(void)
+    {
+        using Swallow = int[];
+        (void) Swallow{ 1, (detail::get_leaf<Is>(*this)._dec(), void(), int{ })... };
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr void _advance_leaves(std::ptrdiff_t d)
+    {
+        using Swallow = int[];
+        (void) Swallow{ 1, (detail::get_leaf<Is>(*this)._advance(d), void(), int{ })... };
+    }
+    template <typename F>
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr decltype(auto) _apply_at(F&& func, gsl::index i) const
+    {
+        return func(detail::get_leaf<Is>(*this)._deref(i)...);
+    }
+    template <typename F>
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr decltype(auto) _apply_at(F&& func, gsl::index i, std::ptrdiff_t d) const
+    {
+        return func(detail::get_leaf<Is>(*this)._deref(i, d)...);
+    }
+
         // LegacyIterator: dereference, increment
-    [[nodiscard]] MAKESHIFT_DETAIL_FORCEINLINE constexpr reference operator *(void)
+    [[nodiscard]] MAKESHIFT_DETAIL_FORCEINLINE constexpr reference operator *(void) const
     {
         return reference{ detail::get_leaf<Is>(*this)._deref(i_)... };
     }
     MAKESHIFT_DETAIL_FORCEINLINE constexpr DerivedT& operator ++(void)
     {
-        using Swallow = int[];
-        (void) Swallow{ 1, (detail::get_leaf<Is>(*this)._inc(), void(), int{ })... };
+        _inc_leaves();
         ++i_;
         return static_cast<DerivedT&>(*this);
     }
@@ -190,8 +228,7 @@ public:
         // BidirectionalIterator: decrement
     MAKESHIFT_DETAIL_FORCEINLINE constexpr DerivedT& operator --(void)
     {
-        using Swallow = int[];
-        (void) Swallow{ 1, (detail::get_leaf<Is>(*this)._dec(), void(), int{ })... };
+        _dec_leaves();
         --i_;
         return static_cast<DerivedT&>(*this);
     }
@@ -203,14 +240,13 @@ public:
     }
 
         // RandomAccessIterator: subscript, arithmetic, ordering compare
-    [[nodiscard]] MAKESHIFT_DETAIL_FORCEINLINE constexpr reference operator [](std::ptrdiff_t d)
+    [[nodiscard]] MAKESHIFT_DETAIL_FORCEINLINE constexpr reference operator [](std::ptrdiff_t d) const
     {
         return reference{ detail::get_leaf<Is>(*this)._deref(i_, d)... };
     }
     MAKESHIFT_DETAIL_FORCEINLINE constexpr DerivedT& operator +=(std::ptrdiff_t d)
     {
-        using Swallow = int[];
-        (void) Swallow{ 1, (detail::get_leaf<Is>(*this)._advance(d), void(), int{ })... };
+        _advance_leaves(d);
         i_ += d;
         return static_cast<DerivedT&>(*this);
     }
@@ -255,10 +291,15 @@ public:
     }
 
     template <typename F>
-    MAKESHIFT_DETAIL_FORCEINLINE constexpr decltype(auto) apply(F&& func)
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr decltype(auto) apply(F&& func) const
     {
         return func(detail::get_leaf<Is>(*this)._deref(i_)...);
     }
+    template <typename F>
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr decltype(auto) apply(F&& func, std::ptrdiff_t d) const
+    {
+        return func(detail::get_leaf<Is>(*this)._deref(i_, d)...);
+    }
 };
 template <typename N, typename... Rs>
 struct zip_iterator
@@ -433,9 +474,9 @@ class zip_range
     using base::base;
 };
 template <typename N, typename... Rs>
-constexpr zip_range<N, Rs...> make_zip_range(N n, Rs&&... ranges)
+constexpr zip_range<N, zip_range_element_t<Rs>...> make_zip_range(N n, Rs&&... ranges)
 {
-    return zip_range<N, Rs...>(n, std::forward<Rs>(ranges)...);
+    return zip_range<N, zip_range_element_t<Rs>...>(n, std::forward<Rs>(ranges)...);
 }
 
 template <typename N, typename... Rs>
@@ -456,9 +497,890 @@ public:
     }
 };
 template <typename N, typename... Rs>
-constexpr zip_common_range<N, Rs...> make_zip_common_range(N n, Rs&&... ranges)
+constexpr zip_common_range<N, zip_range_element_t<Rs>...> make_zip_common_range(N n, Rs&&... ranges)
+{
+    return zip_common_range<N, zip_range_element_t<Rs>...>(n, std::forward<Rs>(ranges)...);
+}
+
+
+template <typename F, typename N, typename... Rs>
+class transform_iterator
+    : public zip_iterator_base<transform_iterator<F, N, Rs...>, N, std::make_index_sequence<sizeof...(Rs)>, Rs...>
+{
+    using base = zip_iterator_base<transform_iterator<F, N, Rs...>, N, std::make_index_sequence<sizeof...(Rs)>, Rs...>;
+
+private:
+    F const* func_;
+
+public:
+    using reference = decltype(std::declval<base const&>().apply(std::declval<F const&>()));
+    using value_type = std::remove_cv_t<std::remove_reference_t<reference>>;
+
+    explicit constexpr transform_iterator(F const& _func, Rs&... ranges)
+        : base(ranges...), func_(&_func)
+    {
+    }
+    explicit constexpr transform_iterator(end_tag, F const& _func, N _size, Rs&... ranges)
+        : base(end_tag{ }, _size, ranges...), func_(&_func)
+    {
+    }
+
+        // for `zip_iterator_leaf_base<..., iterator_mode::transform>`
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr reference _deref_at(gsl::index i) const
+    {
+        return this->_apply_at(*func_, i);
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr reference _deref_at(gsl::index i, std::ptrdiff_t d) const
+    {
+        return this->_apply_at(*func_, i, d);
+    }
+
+    [[nodiscard]] MAKESHIFT_DETAIL_FORCEINLINE constexpr reference operator *(void) const
+    {
+        return this->apply(*func_);
+    }
+    [[nodiscard]] MAKESHIFT_DETAIL_FORCEINLINE constexpr reference operator [](std::ptrdiff_t d) const
+    {
+        return std::apply(*func_, base::operator [](d));
+    }
+};
+
+    // Lazy range of the results of a function applied to the elements of zipped ranges, as returned by `range_transform()`.
+    // When used as an argument of `range_zip()`, `range_for()`, or other `range_*()` algorithms, the transformation is fused into
+    // the loop of the algorithm: the leaves of the underlying ranges are advanced along with the enclosing iterator, and elements
+    // are accessed with the index of the enclosing iterator.
+template <typename F, typename N, typename... Rs>
+class transform_range
+    : public zip_range_size_base<N>
 {
-    return zip_common_range<N, Rs...>(n, std::forward<Rs>(ranges)...);
+public:
+    using iterator = transform_iterator<F, N, Rs&...>;
+    using const_iterator = transform_iterator<F, N, Rs const&...>;
+
+private:
+    F func_;
+    std::tuple<Rs...> ranges_;
+
+    template <typename It, typename TupleT>
+    constexpr It _begin(TupleT& ranges) const
+    {
+        return std::apply(
+            [this](auto&... _ranges)
+            {
+                return It(func_, _ranges...);
+            },
+            ranges);
+    }
+    template <typename It, typename TupleT>
+    constexpr It _end(TupleT& ranges) const
+    {
+        return std::apply(
+            [this](auto&... _ranges)
+            {
+                return It(end_tag{ }, func_, this->_size(), _ranges...);
+            },
+            ranges);
+    }
+
+public:
+    explicit constexpr transform_range(N _size, F _func, Rs... _ranges)
+        : zip_range_size_base<N>(_size),
+          func_(std::move(_func)),
+          ranges_(std::forward<Rs>(_ranges)...)
+    {
+    }
+
+        // for `range_size()`
+    using zip_range_size_base<N>::_size;
+
+        // Like `zip_range<>`, a transform range propagates its constness to the ranges it holds by value.
+    [[nodiscard]] constexpr iterator
+    begin(void)
+    {
+        return _begin<iterator>(ranges_);
+    }
+    [[nodiscard]] constexpr const_iterator
+    begin(void) const
+    {
+        return _begin<const_iterator>(ranges_);
+    }
+    [[nodiscard]] constexpr auto
+    end(void) // overwriting `zip_range_size_base<>::end()`
+    {
+        if constexpr (std::is_same<N, dim_constant<unknown_size>>::value) return zip_range_size_base<N>::end();
+        else return _end<iterator>(ranges_);
+    }
+    [[nodiscard]] constexpr auto
+    end(void) const
+    {
+        if constexpr (std::is_same<N, dim_constant<unknown_size>>::value) return zip_range_size_base<N>::end();
+        else return _end<const_iterator>(ranges_);
+    }
+
+        // for `zip_iterator_leaf_base<..., iterator_mode::transform>`
+    constexpr iterator
+    _end_iterator(void)
+    {
+        return _end<iterator>(ranges_);
+    }
+    constexpr const_iterator
+    _end_iterator(void) const
+    {
+        return _end<const_iterator>(ranges_);
+    }
+
+    template <bool IsRandomAccess = ranges_are_random_access_<Rs...>::value, std::enable_if_t<IsRandomAccess, int> = 0>
+    [[nodiscard]] constexpr MAKESHIFT_DETAIL_FORCEINLINE typename iterator::reference
+    operator [](std::size_t i)
+    {
+        return begin()[std::ptrdiff_t(i)];
+    }
+    template <bool IsRandomAccess = ranges_are_random_access_<Rs...>::value, std::enable_if_t<IsRandomAccess, int> = 0>
+    [[nodiscard]] constexpr MAKESHIFT_DETAIL_FORCEINLINE typename const_iterator::reference
+    operator [](std::size_t i) const
+    {
+        return begin()[std::ptrdiff_t(i)];
+    }
+};
+template <typename N, typename F, typename... Rs>
+constexpr transform_range<std::decay_t<F>, N, Rs...> make_transform_range(N n, F&& func, Rs&&... ranges)
+{
+    return transform_range<std::decay_t<F>, N, Rs...>(n, std::forward<F>(func), std::forward<Rs>(ranges)...);
+}
+
+template <std::size_t I, typename R>
+struct MAKESHIFT_DETAIL_EMPTY_BASES zip_iterator_leaf_base<I, R, iterator_mode::transform> : zip_iterator_defaults
+{
+    using iterator = decltype(std::declval<R&>().begin());
+    using value_type = typename iterator::value_type;
+    using reference = typename iterator::reference;
+
+        // The index of the embedded iterator is not used; elements are accessed with the index of the enclosing iterator instead.
+    iterator pos;
+
+    constexpr zip_iterator_leaf_base(R& range)
+        : pos(range.begin())
+    {
+    }
+    constexpr zip_iterator_leaf_base(R& range, end_tag)
+        : pos(range._end_iterator())
+    {
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr void _inc(void)
+    {
+        pos._inc_leaves();
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr void _dec(void)
+    {
+        pos._dec_leaves();
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr void _advance(std::ptrdiff_t d)
+    {
+        pos._advance_leaves(d);
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr reference _deref(gsl::index i) const
+    {
+        return pos._deref_at(i);
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr reference _deref(gsl::index i, std::ptrdiff_t d) const
+    {
+        return pos._deref_at(i, d);
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr void _check_end(bool isEnd) const
+    {
+        pos._check_end(isEnd);
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr auto _is_end(void) const
+    {
+        return pos._is_end_leaves();
+    }
+};
+
+
+struct forward_element_t
+{
+    template <typename T>
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr T operator ()(T&& arg) const noexcept
+    {
+        return std::forward<T>(arg);
+    }
+};
+static constexpr inline forward_element_t forward_element{ };
+
+template <typename R>
+constexpr auto
+indirect_data_begin(R& range)
+{
+    if constexpr (has_data<R&>::value)
+    {
+        return std::data(range);
+    }
+    else
+    {
+        return detail::range_begin(range);
+    }
+}
+
+    // Range of the elements of a random-access data range referred to by the elements of an index range, as returned by
+    // `indirect_range()`. If `PrefetchDistance > 0`, dereferencing the element at position `i` also issues a prefetch for
+    // the data element referred to by the index at position `i + PrefetchDistance`.
+template <typename IndexR, typename DataR, std::ptrdiff_t PrefetchDistance>
+class indirect_range
+{
+private:
+    mutable std::tuple<IndexR, DataR> ranges_; // shallow constness, cf. `zip_range_base<>`
+
+public:
+    using index_range = std::remove_reference_t<IndexR>;
+    using data_range = std::remove_reference_t<DataR>;
+    static constexpr std::ptrdiff_t prefetch_distance = PrefetchDistance;
+    using iterator = transform_iterator<forward_element_t, decltype(detail::range_size(std::declval<IndexR&>())), indirect_range const&>;
+    using const_iterator = iterator;
+
+    explicit constexpr indirect_range(IndexR _indices, DataR _data)
+        : ranges_(std::forward<IndexR>(_indices), std::forward<DataR>(_data))
+    {
+    }
+
+        // for `zip_iterator_leaf_base<..., iterator_mode::indirect>` and `range_size()`
+    constexpr index_range& _indices(void) const noexcept
+    {
+        return std::get<0>(ranges_);
+    }
+    constexpr data_range& _data(void) const noexcept
+    {
+        return std::get<1>(ranges_);
+    }
+
+    [[nodiscard]] constexpr iterator
+    begin(void) const
+    {
+        return iterator(forward_element, *this);
+    }
+    [[nodiscard]] constexpr iterator
+    end(void) const
+    {
+        return iterator(end_tag{ }, forward_element, detail::range_size(_indices()), *this);
+    }
+        // only available if the size of the index range is known
+    template <bool HasKnownSize = !std::is_same<decltype(detail::range_size(std::declval<IndexR&>())), dim_constant<unknown_size>>::value, std::enable_if_t<HasKnownSize, int> = 0>
+    [[nodiscard]] constexpr std::size_t
+    size(void) const noexcept
+    {
+        return std::size_t(gsl::dim(detail::range_size(_indices())));
+    }
+    [[nodiscard]] constexpr MAKESHIFT_DETAIL_FORCEINLINE typename iterator::reference
+    operator [](std::size_t i) const
+    {
+        return begin()[i];
+    }
+};
+template <std::ptrdiff_t PrefetchDistance, typename IndexR, typename DataR>
+constexpr indirect_range<IndexR, DataR, PrefetchDistance>
+make_indirect_range(IndexR&& indices, DataR&& data)
+{
+    return indirect_range<IndexR, DataR, PrefetchDistance>(std::forward<IndexR>(indices), std::forward<DataR>(data));
+}
+
+template <std::size_t I, typename R>
+struct MAKESHIFT_DETAIL_EMPTY_BASES zip_iterator_leaf_base<I, R, iterator_mode::indirect>
+{
+    using range_type = std::remove_cv_t<std::remove_reference_t<R>>;
+    using index_leaf = zip_iterator_leaf<I, typename range_type::index_range>;
+    using data_iterator = decltype(detail::indirect_data_begin(std::declval<typename range_type::data_range&>()));
+    using value_type = typename std::iterator_traits<data_iterator>::value_type;
+    using reference = typename std::iterator_traits<data_iterator>::reference;
+    using data_size_type = decltype(detail::range_size(std::declval<typename range_type::data_range&>()));
+
+    index_leaf index;
+    data_iterator data;
+    gsl::dim size;
+    data_size_type dataSize;
+
+    constexpr zip_iterator_leaf_base(R& range)
+        : index(range._indices()), data(detail::indirect_data_begin(range._data())), size(detail::range_size(range._indices())),
+          dataSize(detail::range_size(range._data()))
+    {
+    }
+    constexpr zip_iterator_leaf_base(R& range, end_tag)
+        : index(range._indices(), end_tag{ }), data(detail::indirect_data_begin(range._data())), size(detail::range_size(range._indices())),
+          dataSize(detail::range_size(range._data()))
+    {
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr gsl::index _checked(gsl::index j) const
+    {
+        if constexpr (!std::is_same<data_size_type, dim_constant<unknown_size>>::value)
+        {
+            gsl_ExpectsAudit(j >= 0 && j < gsl::dim(dataSize)); // make sure index is valid
+        }
+        return j;
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr void _inc(void)
+    {
+        index._inc();
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr void _dec(void)
+    {
+        index._dec();
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr void _advance(std::ptrdiff_t d)
+    {
+        index._advance(d);
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr reference _deref(gsl::index i) const
+    {
+        if constexpr (range_type::prefetch_distance > 0 && std::is_lvalue_reference<reference>::value)
+        {
+                // Prefetching reads ahead in the index range, so the index range must support random access.
+            if (i + range_type::prefetch_distance < size)
+            {
+                MAKESHIFT_DETAIL_PREFETCH(std::addressof(data[index._deref(i, range_type::prefetch_distance)]));
+            }
+        }
+        return data[_checked(gsl::index(index._deref(i)))];
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr reference _deref(gsl::index i, std::ptrdiff_t d) const
+    {
+        return data[_checked(gsl::index(index._deref(i, d)))];
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr void _check_end(bool isEnd) const
+    {
+        index._check_end(isEnd);
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr auto _is_end(void) const
+    {
+        return index._is_end();
+    }
+};
+
+template <typename C>
+constexpr auto
+to_range_size(C count)
+{
+    if constexpr (is_constval_<C>::value)
+    {
+        static_assert(C::value >= 0, "range size must be non-negative");
+        return dim_constant<gsl::dim(C::value)>{ };
+    }
+    else
+    {
+        gsl_Expects(count >= 0);
+        return gsl::dim(count);
+    }
+}
+template <typename C>
+constexpr auto
+to_stride(C stride)
+{
+    if constexpr (is_constval_<C>::value)
+    {
+        return std::integral_constant<gsl::stride, gsl::stride(C::value)>{ };
+    }
+    else
+    {
+        return gsl::stride(stride);
+    }
+}
+
+    // Addresses the element `element` itself, or its data member `element.*member`.
+template <typename T>
+MAKESHIFT_DETAIL_FORCEINLINE constexpr T&
+strided_element(T& element, no_member) noexcept
+{
+    return element;
+}
+template <typename T, typename M>
+MAKESHIFT_DETAIL_FORCEINLINE constexpr auto&
+strided_element(T& element, M member) noexcept
+{
+    return element.*member;
+}
+
+    // Range of `size` elements at `data[0]`, `data[stride]`, `data[2*stride]`, ..., or of their data members
+    // `data[0].*member`, `data[stride].*member`, ..., as returned by `strided_range()`. Both the size and the stride can be
+    // either runtime values or constvals.
+template <typename T, typename N, typename S, typename M>
+class strided_range : private zip_range_size_base<N>
+{
+private:
+    T* data_;
+    S stride_;
+    M member_;
+
+public:
+    using element_type = std::remove_reference_t<decltype(detail::strided_element(std::declval<T&>(), std::declval<M>()))>;
+    using value_type = std::remove_cv_t<element_type>;
+    using iterator = transform_iterator<forward_element_t, N, strided_range const&>;
+    using const_iterator = iterator;
+
+    explicit constexpr strided_range(T* _data, N _size, S _stride, M _member = { })
+        : zip_range_size_base<N>(_size), data_(_data), stride_(_stride), member_(_member)
+    {
+    }
+
+        // for `zip_iterator_leaf_base<..., iterator_mode::strided>` and `range_size()`
+    using zip_range_size_base<N>::_size;
+    constexpr T* _data(void) const noexcept
+    {
+        return data_;
+    }
+    constexpr S _stride(void) const noexcept
+    {
+        return stride_;
+    }
+    constexpr M _member(void) const noexcept
+    {
+        return member_;
+    }
+
+    [[nodiscard]] constexpr iterator
+    begin(void) const
+    {
+        return iterator(forward_element, *this);
+    }
+    [[nodiscard]] constexpr iterator
+    end(void) const
+    {
+        return iterator(end_tag{ }, forward_element, this->_size(), *this);
+    }
+    [[nodiscard]] constexpr std::size_t
+    size(void) const noexcept
+    {
+        return std::size_t(gsl::dim(this->_size()));
+    }
+    [[nodiscard]] constexpr bool
+    empty(void) const noexcept
+    {
+        return gsl::dim(this->_size()) == 0;
+    }
+    [[nodiscard]] constexpr gsl::stride
+    stride(void) const noexcept
+    {
+        return stride_;
+    }
+    [[nodiscard]] constexpr MAKESHIFT_DETAIL_FORCEINLINE element_type&
+    operator [](std::size_t i) const
+    {
+        gsl_Expects(gsl::dim(i) < gsl::dim(this->_size()));
+
+        return detail::strided_element(data_[gsl::index(i)*stride_], member_);
+    }
+
+        // Same interface as `soa_span<>::subspan()`; the stride is retained.
+    [[nodiscard]] constexpr strided_range<T, gsl::dim, S, M>
+    subspan(std::size_t offset, std::size_t count = std::size_t(-1)) const
+    {
+        gsl_Expects(offset <= size() && (count == std::size_t(-1) || count <= size() - offset));
+
+        std::size_t newSize = (count != std::size_t(-1))
+            ? count
+            : size() - offset;
+        return strided_range<T, gsl::dim, S, M>(data_ + gsl::index(offset)*stride_, gsl::dim(newSize), stride_, member_);
+    }
+    [[nodiscard]] constexpr strided_range<T, gsl::dim, S, M>
+    first(std::size_t count) const
+    {
+        return subspan(0, count);
+    }
+    [[nodiscard]] constexpr strided_range<T, gsl::dim, S, M>
+    last(std::size_t count) const
+    {
+        gsl_Expects(count <= size());
+
+        return subspan(size() - count, count);
+    }
+};
+template <typename T, typename C, typename S, typename M = no_member>
+constexpr auto
+make_strided_range(T* data, C count, S stride, M member = { })
+{
+    auto size = detail::to_range_size(count);
+    auto strideC = detail::to_stride(stride);
+    return strided_range<T, decltype(size), decltype(strideC), M>(data, size, strideC, member);
+}
+
+template <std::size_t I, typename R>
+struct MAKESHIFT_DETAIL_EMPTY_BASES zip_iterator_leaf_base<I, R, iterator_mode::strided> : zip_iterator_defaults
+{
+    using range_type = std::remove_cv_t<std::remove_reference_t<R>>;
+    using pointer_type = decltype(std::declval<range_type const&>()._data());
+    using stride_type = decltype(std::declval<range_type const&>()._stride());
+    using member_type = decltype(std::declval<range_type const&>()._member());
+    using value_type = typename range_type::value_type;
+    using reference = typename range_type::element_type&;
+
+    pointer_type data;
+    stride_type stride;
+    member_type member;
+
+    constexpr zip_iterator_leaf_base(R& range, end_tag = { })
+        : data(range._data()), stride(range._stride()), member(range._member())
+    {
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr reference _deref(gsl::index i) const
+    {
+        return detail::strided_element(data[i*stride], member);
+    }
+    MAKESHIFT_DETAIL_FORCEINLINE constexpr reference _deref(gsl::index i, std::ptrdiff_t d) const
+    {
+        return detail::strided_element(data[(i + d)*stride], member);
+    }
+};
+
+
+template <typename F, typename ReferenceT> struct accepts_lane_index_;
+template <typename F, typename... Ts> struct accepts_lane_index_<F, std::tuple<Ts...>> : std::is_invocable<F&, index_constant<0>, Ts...> { };
+
+    // Applies the functor to the elements at offset `Lane` from the current iterator position, passing the lane index as a
+    // constval first argument if the functor accepts it.
+template <gsl::index Lane, typename F, typename It>
+MAKESHIFT_DETAIL_FORCEINLINE constexpr void
+apply_lane(F& func, It const& it)
+{
+    if constexpr (accepts_lane_index_<F, typename It::reference>::value)
+    {
+        it.apply(
+            [&func](auto&&... elems)
+            {
+                func(index_constant<Lane>{ }, std::forward<decltype(elems)>(elems)...);
+            },
+            Lane);
+    }
+    else
+    {
+        it.apply(func, Lane);
+    }
+}
+
+template <std::size_t... Lanes, typename F, typename It>
+MAKESHIFT_DETAIL_FORCEINLINE constexpr void
+apply_lanes(std::index_sequence<Lanes...>, F& func, It const& it)
+{
+    (detail::apply_lane<gsl::index(Lanes)>(func, it), ...);
+}
+
+    // The remainder is processed with one guarded step per lane so that every element is passed the same lane index as in the
+    // unrolled loop, i.e. its position modulo the unroll factor.
+template <std::size_t... Lanes, typename F, typename It>
+MAKESHIFT_DETAIL_FORCEINLINE constexpr void
+apply_remainder_lanes(std::index_sequence<Lanes...>, F& func, It const& it, gsl::dim remainder)
+{
+    ((gsl::dim(Lanes) < remainder ? detail::apply_lane<gsl::index(Lanes)>(func, it) : void()), ...);
+}
+
+
+template <typename T> struct is_trivially_copyable_element_ : std::is_trivially_copyable<T> { };
+template <typename... Ts> struct is_trivially_copyable_element_<std::tuple<Ts...>> : std::conjunction<std::is_trivially_copyable<std::remove_cv_t<Ts>>...> { };
+template <typename R> struct range_value_ { using type = typename std::iterator_traits<decltype(detail::range_begin(std::declval<R&>()))>::value_type; };
+template <> struct range_value_<range_index_t> { using type = gsl::index; };
+template <typename R> using range_value_t = typename range_value_<R>::type;
+
+    // Compaction kernels may write range elements unconditionally (i.e. without branching on the predicate) if the elements are
+    // cheap to copy and if the ranges can be advanced by a runtime offset.
+template <typename... Rs> struct ranges_permit_branchless_compaction_
+    : std::conjunction<
+        std::is_base_of<std::random_access_iterator_tag, common_iterator_tag<range_iterator_concept_t<std::decay_t<Rs>>...>>,
+        is_trivially_copyable_element_<range_value_t<std::decay_t<Rs>>>...>
+{
+};
+
+template <typename DstT, typename SrcT>
+MAKESHIFT_DETAIL_FORCEINLINE constexpr void
+assign_element(DstT&& dst, SrcT&& src)
+{
+    dst = std::forward<SrcT>(src);
+}
+template <typename DstT, std::size_t... Is, typename... SrcTs>
+MAKESHIFT_DETAIL_FORCEINLINE constexpr void
+assign_element_1(DstT&& dst, std::index_sequence<Is...>, SrcTs&&... srcs)
+{
+    using std::get;
+    using Swallow = int[];
+    (void) Swallow{ 1, ((get<Is>(dst) = std::forward<SrcTs>(srcs)), void(), int{ })... };
+}
+template <typename DstT, typename SrcT0, typename SrcT1, typename... SrcTs>
+MAKESHIFT_DETAIL_FORCEINLINE constexpr void
+assign_element(DstT&& dst, SrcT0&& src0, SrcT1&& src1, SrcTs&&... srcs)
+{
+    detail::assign_element_1(dst, std::make_index_sequence<2 + sizeof...(SrcTs)>{ },
+        std::forward<SrcT0>(src0), std::forward<SrcT1>(src1), std::forward<SrcTs>(srcs)...);
+}
+
+    // Assigns the current elements of the input iterator to the current element of the output iterator and returns whether
+    // the predicate applies. If `Branchless` is true, the elements are assigned regardless of the predicate. `hasRoom` indicates
+    // whether the output iterator refers to an element; it must be true if the elements are to be assigned.
+template <bool Branchless, typename PredicateT, typename OutputIt, typename InputIt>
+MAKESHIFT_DETAIL_FORCEINLINE constexpr bool
+copy_element_if(PredicateT& predicate, OutputIt const& out, InputIt const& it, bool hasRoom)
+{
+    return it.apply(
+        [&](auto&&... elems)
+        {
+            bool keep = predicate(elems...);
+            if (Branchless || keep)
+            {
+                gsl_Expects(hasRoom);
+                out.apply(
+                    [&](auto&& dst)
+                    {
+                        detail::assign_element(dst, elems...);
+                    });
+            }
+            return keep;
+        });
+}
+
+    // Copies the elements of the input ranges in [it, end) for which the predicate applies to the output range and returns
+    // the number of elements copied, which must not exceed `maxCount`. `end` is either an iterator or a sentinel. If
+    // `Branchless` is true, every set of input elements is written to the current output position, but the output iterator
+    // is advanced only if the predicate applies; the loop then stops after `maxCount` elements have been copied, so
+    // `maxCount` must be the exact number of elements to be copied or must not be less than the number of input elements.
+template <bool Branchless, typename PredicateT, typename OutputIt, typename InputIt, typename EndT>
+constexpr gsl::dim
+copy_if_block(PredicateT& predicate, OutputIt out, gsl::dim maxCount, InputIt it, EndT end)
+{
+    gsl::dim count = 0;
+    if constexpr (Branchless)
+    {
+        for (; it != end && count != maxCount; ++it)
+        {
+            bool keep = detail::copy_element_if<true>(predicate, out, it, true);
+            out += std::ptrdiff_t(keep);
+            count += gsl::dim(keep);
+        }
+    }
+    else
+    {
+        for (; it != end; ++it)
+        {
+            if (detail::copy_element_if<false>(predicate, out, it, count != maxCount))
+            {
+                ++out;
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+template <typename DstIt, typename SrcIt>
+MAKESHIFT_DETAIL_FORCEINLINE constexpr void
+move_elements(DstIt const& dst, SrcIt const& src)
+{
+    dst.apply(
+        [&](auto&&... dstElems)
+        {
+            src.apply(
+                [&](auto&&... srcElems)
+                {
+                    using Swallow = int[];
+                    (void) Swallow{ 1, ((dstElems = std::move(srcElems)), void(), int{ })... };
+                });
+        });
+}
+
+
+    // Computes the full 128-bit product of two 64-bit integers.
+MAKESHIFT_DETAIL_FORCEINLINE constexpr std::uint64_t
+mul_64x64_128(std::uint64_t a, std::uint64_t b, std::uint64_t& lo) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128;
+    uint128 result = uint128(a) * b;
+    lo = std::uint64_t(result);
+    return std::uint64_t(result >> 64);
+#else // defined(__SIZEOF_INT128__)
+    std::uint64_t aLo = a & 0xFFFFFFFFu;
+    std::uint64_t aHi = a >> 32;
+    std::uint64_t bLo = b & 0xFFFFFFFFu;
+    std::uint64_t bHi = b >> 32;
+    std::uint64_t ll = aLo*bLo;
+    std::uint64_t lh = aLo*bHi;
+    std::uint64_t hl = aHi*bLo;
+    std::uint64_t hh = aHi*bHi;
+    std::uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+    lo = (mid << 32) | (ll & 0xFFFFFFFFu);
+    return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif // defined(__SIZEOF_INT128__)
+}
+
+    // URBGs which produce uniformly distributed 32-bit or 64-bit words can be used directly for bounded random number generation.
+template <typename URBG>
+struct is_full_range_urbg_
+    : std::bool_constant<
+        std::remove_reference_t<URBG>::min() == 0
+        && (std::uint64_t(std::remove_reference_t<URBG>::max()) == std::uint64_t(0xFFFFFFFFu)
+         || std::uint64_t(std::remove_reference_t<URBG>::max()) == ~std::uint64_t(0))>
+{
+};
+
+template <typename URBG>
+MAKESHIFT_DETAIL_FORCEINLINE constexpr std::uint64_t
+random_word_64(URBG& rng)
+{
+    if constexpr (std::uint64_t(URBG::max()) == ~std::uint64_t(0))
+    {
+        return std::uint64_t(rng());
+    }
+    else
+    {
+        std::uint64_t hi = std::uint64_t(rng());
+        return (hi << 32) | std::uint64_t(rng());
+    }
+}
+
+    // Returns a uniformly distributed random number in [0, bound) using Lemire's nearly divisionless method (D. Lemire, "Fast
+    // Random Integer Generation in an Interval", 2019).
+template <typename URBG>
+constexpr std::uint64_t
+bounded_random(URBG& rng, std::uint64_t bound)
+{
+    std::uint64_t lo = 0;
+    std::uint64_t result = detail::mul_64x64_128(detail::random_word_64(rng), bound, lo);
+    if (lo < bound)
+    {
+        std::uint64_t threshold = (0 - bound) % bound;
+        while (lo < threshold)
+        {
+            result = detail::mul_64x64_128(detail::random_word_64(rng), bound, lo);
+        }
+    }
+    return result;
+}
+
+    // Returns two independent, uniformly distributed random numbers in [0, bound1) and [0, bound2) computed from a single random
+    // word, where `bound1*bound2` must not exceed 2⁶⁴ (N. Brackett-Rozinsky, D. Lemire, "Batched Ranged Random Integer Generation",
+    // 2024).
+template <typename URBG>
+constexpr void
+bounded_random_2(URBG& rng, std::uint64_t bound1, std::uint64_t bound2, std::uint64_t& result1, std::uint64_t& result2)
+{
+    std::uint64_t lo = 0;
+    result1 = detail::mul_64x64_128(detail::random_word_64(rng), bound1, lo);
+    result2 = detail::mul_64x64_128(lo, bound2, lo);
+    std::uint64_t productBound = bound1*bound2;
+    if (lo < productBound)
+    {
+        std::uint64_t threshold = (0 - productBound) % productBound;
+        while (lo < threshold)
+        {
+            result1 = detail::mul_64x64_128(detail::random_word_64(rng), bound1, lo);
+            result2 = detail::mul_64x64_128(lo, bound2, lo);
+        }
+    }
+}
+
+    // Fisher–Yates shuffle of the elements in [first, first + length) which draws two swap indices from every random word as long
+    // as the product of the bounds fits in 64 bits.
+template <typename RandomIt, typename URBG>
+constexpr void
+shuffle_batched(RandomIt first, std::ptrdiff_t length, URBG& rng)
+{
+    using std::swap;
+
+    std::uint64_t i = std::uint64_t(length);
+    for (; i > (std::uint64_t(1) << 32); --i)
+    {
+        std::uint64_t j = detail::bounded_random(rng, i);
+        swap(first[std::ptrdiff_t(i - 1)], first[std::ptrdiff_t(j)]);
+    }
+    for (; i > 2; i -= 2)
+    {
+        std::uint64_t j1 = 0;
+        std::uint64_t j2 = 0;
+        detail::bounded_random_2(rng, i, i - 1, j1, j2);
+        swap(first[std::ptrdiff_t(i - 1)], first[std::ptrdiff_t(j1)]);
+        swap(first[std::ptrdiff_t(i - 2)], first[std::ptrdiff_t(j2)]);
+    }
+    if (i == 2)
+    {
+        std::uint64_t j = detail::bounded_random(rng, 2);
+        swap(first[1], first[std::ptrdiff_t(j)]);
+    }
+}
+
+
+    // Ranges of at least this many bytes are initialised with non-temporal stores, which bypass the cache hierarchy; initialising
+    // a buffer much larger than the last-level cache with regular stores would only evict data that is still needed.
+constexpr std::size_t nontemporal_store_threshold_bytes = std::size_t(1) << 22;
+
+template <typename R, typename = void> struct contiguous_range_element_ { };
+template <typename R> struct contiguous_range_element_<R, std::void_t<decltype(std::data(std::declval<R&>())), decltype(std::size(std::declval<R&>()))>> { using type = std::remove_pointer_t<decltype(std::data(std::declval<R&>()))>; };
+template <typename R, typename = void> struct is_contiguous_arithmetic_range_ : std::false_type { };
+template <typename R> struct is_contiguous_arithmetic_range_<R, std::void_t<typename contiguous_range_element_<R>::type>>
+    : std::conjunction<
+        std::is_arithmetic<typename contiguous_range_element_<R>::type>,
+        std::negation<std::is_const<typename contiguous_range_element_<R>::type>>>
+{
+};
+
+    // Stores the values returned by successive calls to `next()` to `data[0]`, ..., `data[n - 1]`, using non-temporal stores
+    // for all complete cache lines if supported.
+template <typename T, typename F>
+void
+store_nontemporal(T* data, gsl::dim n, F& next)
+{
+    gsl::index i = 0;
+#if MAKESHIFT_DETAIL_SSE2
+    constexpr std::size_t cacheLineSize = 64;
+    if constexpr (cacheLineSize % sizeof(T) == 0)
+    {
+        constexpr gsl::dim chunkSize = gsl::dim(cacheLineSize/sizeof(T));
+        if (reinterpret_cast<std::uintptr_t>(data) % sizeof(T) == 0)
+        {
+            for (; i != n && reinterpret_cast<std::uintptr_t>(data + i) % cacheLineSize != 0; ++i)
+            {
+                data[i] = next();
+            }
+            alignas(cacheLineSize) T chunk[chunkSize];
+            auto src = reinterpret_cast<__m128i const*>(chunk);
+            for (; n - i >= chunkSize; i += chunkSize)
+            {
+                for (gsl::index j = 0; j != chunkSize; ++j)
+                {
+                    chunk[j] = next();
+                }
+                auto dst = reinterpret_cast<__m128i*>(data + i);
+                _mm_stream_si128(dst + 0, _mm_load_si128(src + 0));
+                _mm_stream_si128(dst + 1, _mm_load_si128(src + 1));
+                _mm_stream_si128(dst + 2, _mm_load_si128(src + 2));
+                _mm_stream_si128(dst + 3, _mm_load_si128(src + 3));
+            }
+            _mm_sfence();  // non-temporal stores are weakly ordered
+        }
+    }
+#endif // MAKESHIFT_DETAIL_SSE2
+    for (; i != n; ++i)
+    {
+        data[i] = next();
+    }
+}
+
+    // Stores the values returned by successive calls to `next()` to the elements of the range. Large contiguous ranges of
+    // arithmetic type are initialised with non-temporal stores.
+template <typename R, typename F>
+constexpr void
+store_sequence(R& range, F&& next)
+{
+    if constexpr (is_contiguous_arithmetic_range_<R>::value)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            using T = typename contiguous_range_element_<R>::type;
+            auto n = std::size(range);
+            if (n*sizeof(T) >= nontemporal_store_threshold_bytes)
+            {
+                detail::store_nontemporal(std::data(range), gsl::dim(n), next);
+                return;
+            }
+        }
+    }
+    auto it = detail::range_begin(range);
+    auto end = detail::range_end(range);
+    for (; it != end; ++it)
+    {
+        *it = next();
+    }
 }
 
 
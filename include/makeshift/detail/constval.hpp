@@ -325,6 +325,16 @@ constval_range_to_array_impl(R&& range)
     return result;
 }
 
+template <typename C, typename ProjT>
+struct constval_range_to_array_functor
+{
+    constexpr auto operator ()(void) const
+    {
+        constexpr std::size_t N = std::size(ProjT{ }(C{ }()));
+        return detail::constval_range_to_array_impl<N>(ProjT{ }(C{ }()));
+    }
+};
+
 
 template <typename C>
 constexpr constval_t<C> make_constval(C const&)
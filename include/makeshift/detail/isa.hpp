@@ -0,0 +1,133 @@
+﻿
+#ifndef INCLUDED_MAKESHIFT_DETAIL_ISA_HPP_
+#define INCLUDED_MAKESHIFT_DETAIL_ISA_HPP_
+
+
+#include <string_view>
+#include <algorithm>    // for min()
+
+#include <makeshift/string.hpp>  // for parse_enum<>()
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+# define MAKESHIFT_DETAIL_X86  1
+# if defined(_MSC_VER) && !defined(__clang__)
+#  include <intrin.h>    // for __cpuid(), __cpuidex(), _xgetbv()
+# else
+#  include <cpuid.h>     // for __get_cpuid_max(), __cpuid_count()
+# endif
+#else
+# define MAKESHIFT_DETAIL_X86  0
+#endif
+
+
+namespace makeshift {
+
+
+enum class isa;
+
+
+namespace detail {
+
+
+#if MAKESHIFT_DETAIL_X86
+struct cpuid_registers
+{
+    unsigned eax, ebx, ecx, edx;
+};
+
+inline cpuid_registers
+cpuid(unsigned leaf, unsigned subleaf)
+{
+# if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuidex(regs, int(leaf), int(subleaf));
+    return { unsigned(regs[0]), unsigned(regs[1]), unsigned(regs[2]), unsigned(regs[3]) };
+# else
+    auto regs = cpuid_registers{ };
+    if (leaf <= __get_cpuid_max(0, nullptr))
+    {
+        __cpuid_count(leaf, subleaf, regs.eax, regs.ebx, regs.ecx, regs.edx);
+    }
+    return regs;
+# endif
+}
+
+    // Reads the XCR0 register, which tells which register states the operating system saves on context switches.
+inline unsigned long long
+read_xcr0(void)
+{
+# if defined(_MSC_VER) && !defined(__clang__)
+    return _xgetbv(0);
+# else
+    unsigned eax, edx;
+    __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+# endif
+}
+
+constexpr bool
+has_bits(unsigned reg, unsigned bits) noexcept
+{
+    return (reg & bits) == bits;
+}
+#endif // MAKESHIFT_DETAIL_X86
+
+    // The ISA levels correspond to the x86-64 micro-architecture levels v2, v3, and v4, less the features which compilers do
+    // not use for code generation.
+template <typename IsaT>
+IsaT
+detect_isa(void)
+{
+#if MAKESHIFT_DETAIL_X86
+    auto leaf1 = detail::cpuid(1, 0);
+    auto leaf7 = detail::cpuid(7, 0);
+
+    constexpr unsigned sse4_2 = 1u << 20;  // ECX
+    constexpr unsigned popcnt = 1u << 23;  // ECX
+    if (!has_bits(leaf1.ecx, sse4_2 | popcnt)) return IsaT::scalar;
+
+        // AVX requires the operating system to save the YMM registers, and AVX-512 additionally requires it to save the opmask
+        // and ZMM registers.
+    constexpr unsigned fma = 1u << 12;      // ECX
+    constexpr unsigned osxsave = 1u << 27;  // ECX
+    constexpr unsigned avx = 1u << 28;      // ECX
+    constexpr unsigned bmi1 = 1u << 3;      // EBX
+    constexpr unsigned avx2 = 1u << 5;      // EBX
+    constexpr unsigned bmi2 = 1u << 8;      // EBX
+    if (!has_bits(leaf1.ecx, fma | osxsave | avx) || !has_bits(leaf7.ebx, bmi1 | avx2 | bmi2)) return IsaT::sse4_2;
+    unsigned long long xcr0 = detail::read_xcr0();
+    constexpr unsigned long long ymmState = 0x6;   // XMM and YMM
+    constexpr unsigned long long zmmState = 0xE0;  // opmask, upper halves of ZMM0-15, and ZMM16-31
+    if ((xcr0 & ymmState) != ymmState) return IsaT::sse4_2;
+
+    constexpr unsigned avx512f = 1u << 16;   // EBX
+    constexpr unsigned avx512dq = 1u << 17;  // EBX
+    constexpr unsigned avx512cd = 1u << 28;  // EBX
+    constexpr unsigned avx512bw = 1u << 30;  // EBX
+    constexpr unsigned avx512vl = 1u << 31;  // EBX
+    if (!has_bits(leaf7.ebx, avx512f | avx512dq | avx512cd | avx512bw | avx512vl) || (xcr0 & zmmState) != zmmState) return IsaT::avx2;
+
+    return IsaT::avx512;
+#else // MAKESHIFT_DETAIL_X86
+    return IsaT::scalar;
+#endif // MAKESHIFT_DETAIL_X86
+}
+
+
+    // Applies the override given in the `MAKESHIFT_ISA` environment variable, if any. The override can only lower the ISA level
+    // because the kernels for higher levels would not run on the current machine.
+template <typename IsaT>
+IsaT
+select_isa(IsaT detected, char const* override)
+{
+    if (override == nullptr || *override == '\0') return detected;
+    return std::min(detected, makeshift::parse_enum<IsaT>(std::string_view(override)));
+}
+
+
+} // namespace detail
+
+} // namespace makeshift
+
+
+#endif // INCLUDED_MAKESHIFT_DETAIL_ISA_HPP_
@@ -0,0 +1,79 @@
+﻿
+#ifndef INCLUDED_MAKESHIFT_DETAIL_LUT_HPP_
+#define INCLUDED_MAKESHIFT_DETAIL_LUT_HPP_
+
+
+#include <array>
+#include <cstddef>      // for size_t
+#include <utility>      // for index_sequence<>
+#include <type_traits>  // for remove_cvref<>
+
+#include <gsl-lite/gsl-lite.hpp>  // for type_identity<>
+
+#include <makeshift/constval.hpp>  // for MAKESHIFT_CONSTVAL()
+#include <makeshift/metadata.hpp>  // for values<>(), is_available_v<>
+
+
+namespace makeshift {
+
+namespace gsl = ::gsl_lite;
+
+
+namespace detail {
+
+
+template <typename ValuesC> using lut_domain_value_t = typename std::remove_cvref_t<decltype(ValuesC::value)>::value_type;
+template <typename ValuesC> constexpr std::size_t lut_domain_size_v = std::tuple_size_v<std::remove_cvref_t<decltype(ValuesC::value)>>;
+
+template <typename ValuesC>
+constexpr ValuesC
+lut_domain(ValuesC valuesC)
+{
+    return valuesC;
+}
+template <typename T>
+constexpr auto
+lut_domain(gsl::type_identity<T>)
+{
+    if constexpr (metadata::is_available_v<decltype(metadata::values<T>())>)
+    {
+        return MAKESHIFT_CONSTVAL(metadata::values<T>());
+    }
+    else
+    {
+        static_assert(!sizeof(gsl::type_identity<T>), "make_lut() cannot find admissible values");
+    }
+}
+
+    // Evaluates the function for every combination of domain values. The table is stored in row-major order, i.e. the index
+    // into the last domain varies fastest.
+template <typename R, typename... ValuesCs, std::size_t... Is, typename F>
+constexpr auto
+make_lut_data(std::index_sequence<Is...>, F& func)
+{
+    constexpr std::size_t size = (lut_domain_size_v<ValuesCs> * ... * std::size_t(1));
+    constexpr std::array<std::size_t, sizeof...(ValuesCs)> extents = { lut_domain_size_v<ValuesCs>... };
+
+    auto result = std::array<R, size>{ };
+    auto indices = std::array<std::size_t, sizeof...(ValuesCs)>{ };
+    for (std::size_t k = 0; k != size; ++k)
+    {
+        result[k] = func(ValuesCs::value[indices[Is]]...);
+
+            // Increment the multi-index.
+        for (std::size_t d = sizeof...(ValuesCs); d-- != 0; )
+        {
+            if (++indices[d] != extents[d]) break;
+            indices[d] = 0;
+        }
+    }
+    return result;
+}
+
+
+} // namespace detail
+
+} // namespace makeshift
+
+
+#endif // INCLUDED_MAKESHIFT_DETAIL_LUT_HPP_
@@ -29,4 +29,25 @@
 #endif
 
 
+    //
+    // `MAKESHIFT_DETAIL_PREFETCH(p)` hints the processor to load the cache line at the given address.
+    //
+#if defined(__GNUC__)
+# define MAKESHIFT_DETAIL_PREFETCH(p)  __builtin_prefetch(p)
+#else
+# define MAKESHIFT_DETAIL_PREFETCH(p)  ((void) (p))
+#endif
+
+
+    //
+    // `MAKESHIFT_DETAIL_SSE2` is defined as 1 if SSE2 intrinsics (in particular non-temporal stores) are available, and as 0
+    // otherwise.
+    //
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define MAKESHIFT_DETAIL_SSE2  1
+#else
+# define MAKESHIFT_DETAIL_SSE2  0
+#endif
+
+
 #endif // INCLUDED_MAKESHIFT_DETAIL_MACROS_HPP_
@@ -137,24 +137,25 @@ template <typename T, typename M, std::size_t... Is> struct is_member_tuple_0_<T
 template <typename T, typename M, typename = void> struct is_member_tuple : std::false_type { };
 template <typename T, typename M> struct is_member_tuple<T, M, std::void_t<typename std::tuple_size<M>::type>> : is_member_tuple_0_<T, M, std::make_index_sequence<std::tuple_size_v<M>>> { };
 
-template <typename T, typename M, template <typename...> class PredT, std::size_t N, std::size_t I, int Occurrence, typename ArgsT>
+template <std::size_t N>
+constexpr std::size_t
+find_nth_flag(std::array<bool, N> const& flags, int occurrence) noexcept
+{
+    for (std::size_t i = 0; i != N; ++i)
+    {
+        if (flags[i] && occurrence-- == 0) return i;
+    }
+    return std::size_t(-1);
+}
+template <typename T, typename M, template <typename...> class PredT, int Occurrence, typename Is, typename ArgsT>
 struct record_index_0_;
-template <typename T, typename M, template <typename...> class PredT, std::size_t N, std::size_t I, int Occurrence, bool Match, typename ArgsT>
-struct record_index_1_;
-template <typename T, typename M, template <typename...> class PredT, std::size_t N, std::size_t I, typename ArgsT>
-struct record_index_1_<T, M, PredT, N, I, 0, true, ArgsT> : std::integral_constant<std::size_t, I> { };
-template <typename T, typename M, template <typename...> class PredT, std::size_t N, std::size_t I, int Occurrence, typename ArgsT>
-struct record_index_1_<T, M, PredT, N, I, Occurrence, true, ArgsT> : record_index_0_<T, M, PredT, N, I + 1, Occurrence - 1, ArgsT> { };
-template <typename T, typename M, template <typename...> class PredT, std::size_t N, std::size_t I, int Occurrence, typename ArgsT>
-struct record_index_1_<T, M, PredT, N, I, Occurrence, false, ArgsT> : record_index_0_<T, M, PredT, N, I + 1, Occurrence, ArgsT> { };
-template <typename T, typename M, template <typename...> class PredT, std::size_t N, std::size_t I, int Occurrence, typename... ArgsT>
-struct record_index_0_<T, M, PredT, N, I, Occurrence, type_sequence<ArgsT...>> : record_index_1_<T, M, PredT, N, I, Occurrence, PredT<T, std::tuple_element_t<I, M>, ArgsT...>::value, type_sequence<ArgsT...>> { };
-template <typename T, typename M, template <typename...> class PredT, std::size_t N, int Occurrence, typename... ArgsT>
-struct record_index_0_<T, M, PredT, N, N, Occurrence, type_sequence<ArgsT...>> : std::integral_constant<std::size_t, std::size_t(-1)> { };
+template <typename T, typename M, template <typename...> class PredT, int Occurrence, std::size_t... Is, typename... ArgsT>
+struct record_index_0_<T, M, PredT, Occurrence, std::index_sequence<Is...>, type_sequence<ArgsT...>>
+    : std::integral_constant<std::size_t, detail::find_nth_flag(std::array<bool, sizeof...(Is)>{ bool(PredT<T, std::tuple_element_t<Is, M>, ArgsT...>::value)... }, Occurrence)> { };
 template <typename T, typename M, template <typename...> class PredT, int Occurrence, typename, typename ArgsT>
 struct record_index : std::integral_constant<std::size_t, std::size_t(-1)> { };
 template <typename T, typename M, template <typename...> class PredT, int Occurrence, typename ArgsT>
-struct record_index<T, M, PredT, Occurrence, std::void_t<typename std::tuple_size<M>::type>, ArgsT> : record_index_0_<T, M, PredT, std::tuple_size_v<M>, 0, Occurrence, ArgsT> { };
+struct record_index<T, M, PredT, Occurrence, std::void_t<typename std::tuple_size<M>::type>, ArgsT> : record_index_0_<T, M, PredT, Occurrence, std::make_index_sequence<std::tuple_size_v<M>>, ArgsT> { };
 
 template <typename T, typename M, template <typename...> class PredT, int Occurrence, typename Is, typename ArgsT>
 struct record_indices_0_;
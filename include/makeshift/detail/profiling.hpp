@@ -0,0 +1,109 @@
+﻿
+#ifndef INCLUDED_MAKESHIFT_DETAIL_PROFILING_HPP_
+#define INCLUDED_MAKESHIFT_DETAIL_PROFILING_HPP_
+
+
+#include <array>
+#include <atomic>
+#include <cstddef>          // for size_t, ptrdiff_t
+#include <cstdint>          // for uint_least64_t
+#include <ostream>
+#include <type_traits>      // for is_same<>, remove_cv<>, remove_reference<>, remove_cvref<>, declval<>()
+#include <source_location>
+
+#include <makeshift/metadata.hpp>     // for values<>(), value_names<>(), is_available_v<>
+#include <makeshift/type_traits.hpp>  // for can_instantiate<>
+
+
+namespace makeshift {
+
+namespace gsl = ::gsl_lite;
+
+
+namespace detail {
+
+
+    //
+    // Hit counters for one call site of `expand()`, `try_expand()`, or `expand_failfast()`. Sites register themselves in a
+    // lock-free intrusive list upon first use and are never unregistered.
+    //
+struct dispatch_profile_site
+{
+    std::source_location location;
+    char const* function;
+    std::size_t numAlternatives;
+    std::atomic<std::uint_least64_t>* hits; // `numAlternatives` alternatives followed by the number of unsupported values
+    void (*printAlternative)(std::ostream& stream, std::size_t index);
+    dispatch_profile_site* next;
+
+    dispatch_profile_site(std::source_location const& _location, char const* _function, std::size_t _numAlternatives,
+        std::atomic<std::uint_least64_t>* _hits, void (*_printAlternative)(std::ostream&, std::size_t)) noexcept;
+};
+
+inline std::atomic<dispatch_profile_site*> dispatch_profile_sites{ nullptr };
+
+inline dispatch_profile_site::dispatch_profile_site(std::source_location const& _location, char const* _function,
+    std::size_t _numAlternatives, std::atomic<std::uint_least64_t>* _hits, void (*_printAlternative)(std::ostream&, std::size_t)) noexcept
+    : location(_location), function(_function), numAlternatives(_numAlternatives), hits(_hits), printAlternative(_printAlternative),
+      next(dispatch_profile_sites.load(std::memory_order_relaxed))
+{
+    while (!dispatch_profile_sites.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+}
+
+template <typename T> using ostream_r = decltype(std::declval<std::ostream&>() << std::declval<T const&>());
+
+template <typename ValuesC>
+void print_dispatch_alternative(std::ostream& stream, std::size_t index)
+{
+    using T = typename std::remove_cv_t<std::remove_reference_t<decltype(ValuesC::value)>>::value_type;
+
+    auto const& value = ValuesC::value[index];
+    if constexpr (metadata::is_available_v<std::remove_cvref_t<decltype(metadata::value_names<T>())>>)
+    {
+            // The list of values passed to `expand()` may be a subset of the reflected values, so we look up the name by value.
+        constexpr auto allValues = metadata::values<T>();
+        constexpr auto names = metadata::value_names<T>();
+        for (std::size_t i = 0; i != allValues.size(); ++i)
+        {
+            if (allValues[i] == value)
+            {
+                stream << names[i];
+                return;
+            }
+        }
+    }
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        stream << (value ? "true" : "false");
+    }
+    else if constexpr (can_instantiate_v<ostream_r, T>)
+    {
+        stream << value;
+    }
+    else
+    {
+        stream << '#' << index;
+    }
+}
+
+template <typename SiteT, typename ValuesC>
+void record_dispatch(std::source_location const& location, char const* function, std::ptrdiff_t index)
+{
+    constexpr std::size_t numAlternatives = std::tuple_size_v<std::remove_cv_t<std::remove_reference_t<decltype(ValuesC::value)>>>;
+
+    static std::atomic<std::uint_least64_t> hits[numAlternatives + 1];
+    static dispatch_profile_site site{ location, function, numAlternatives, hits, &print_dispatch_alternative<ValuesC> };
+
+    std::size_t slot = index >= 0 ? std::size_t(index) : numAlternatives;
+    hits[slot].fetch_add(1, std::memory_order_relaxed);
+}
+
+
+} // namespace detail
+
+} // namespace makeshift
+
+
+#endif // INCLUDED_MAKESHIFT_DETAIL_PROFILING_HPP_
@@ -3,6 +3,7 @@
 #define INCLUDED_MAKESHIFT_DETAIL_TYPE_TRAITS_HPP_
 
 
+#include <array>
 #include <cstddef>      // for size_t
 #include <iterator>     // for begin(), end()
 #include <utility>      // for integer_sequence<>, tuple_size<>
@@ -78,11 +79,11 @@ struct type_pack_index_
 };
 
 
-#ifdef __clang__
+#ifdef __has_builtin
 # if __has_builtin(__type_pack_element)
 #  define MAKESHIFT_BUILTIN_TYPE_PACK_ELEMENT_
 # endif // __has_builtin(__type_pack_element)
-#endif // __clang__
+#endif // __has_builtin
 
 #ifdef MAKESHIFT_BUILTIN_TYPE_PACK_ELEMENT_
 template <std::size_t I, typename... Ts> struct nth_type_ { using type = __type_pack_element<I, Ts...>; };
@@ -132,41 +133,61 @@ template <std::size_t... Is, typename... Ts> struct type_set_0_<std::index_seque
 template <typename... Ts> struct type_set_ : type_set_0_<std::index_sequence_for<Ts...>, Ts...> { };
 template <typename T, typename... Ts> struct is_in_ : std::is_base_of<type_set_leaf_<T>, type_set_<Ts...>> { };
 
-template <typename Rs, typename Ts> struct unique_sequence_0_;
-template <typename Rs> struct unique_sequence_0_<Rs, type_set_<>> { using type = Rs; };
-template <typename Rs, bool IsIn, typename T0, typename Ts> struct unique_sequence_1_;
-template <typename Rs, typename T0, typename Ts> struct unique_sequence_1_<Rs, true, T0, Ts> : unique_sequence_0_<Rs, Ts> { };
-template <template <typename...> class TypeSeqT, typename... Rs, typename T0, typename Ts> struct unique_sequence_1_<TypeSeqT<Rs...>, false, T0, Ts> : unique_sequence_0_<TypeSeqT<Rs..., T0>, Ts> { };
-template <typename Rs, typename T0, typename... Ts> struct unique_sequence_0_<Rs, type_set_<T0, Ts...>> : unique_sequence_1_<Rs, is_in_<T0, Ts...>::value, T0, type_set_<Ts...>> { };
-template <typename Ts> struct unique_sequence_;
-template <template <typename...> class TypeSeqT, typename... Ts> struct unique_sequence_<TypeSeqT<Ts...>> : unique_sequence_0_<TypeSeqT<>, type_set_<Ts...>> { };
-
-template <typename Rs, template <typename> class PredT, typename Ts> struct filter_sequence_0_;
-template <typename Rs, template <typename> class PredT, bool TakeT0, typename T0, typename Ts> struct filter_sequence_1_;
-template <typename... Rs, template <typename> class PredT, template <typename...> class TypeSeqT, typename T0, typename Ts>
-struct filter_sequence_1_<TypeSeqT<Rs...>, PredT, true, T0, Ts>
-    : filter_sequence_0_<TypeSeqT<Rs..., T0>, PredT, Ts> { };
-template <typename Rs, template <typename> class PredT, typename T0, typename Ts>
-struct filter_sequence_1_<Rs, PredT, false, T0, Ts>
-    : filter_sequence_0_<Rs, PredT, Ts> { };
-template <typename Rs, template <typename> class PredT, template <typename...> class TypeSeqT, typename T0, typename... Ts>
-struct filter_sequence_0_<Rs, PredT, TypeSeqT<T0, Ts...>>
-    : filter_sequence_1_<Rs, PredT, PredT<T0>::value, T0, TypeSeqT<Ts...>> { };
-template <typename Rs, template <typename> class PredT, template <typename...> class TypeSeqT>
-struct filter_sequence_0_<Rs, PredT, TypeSeqT<>>
+    // The sequence algorithms below avoid recursing once per element: they compute a mask of the elements to keep with a fold
+    // expression, turn it into a table of indices in a constexpr function, and then pick the elements with `nth_type_<>`.
+template <std::size_t N>
+constexpr std::size_t
+find_last_flag(bool const (&flags)[N]) noexcept
+{
+    std::size_t i = N;
+    while (i != 0 && !flags[i - 1]) --i;
+    return i - 1;
+}
+template <bool... Mask>
+struct mask_selection_
+{
+    static constexpr std::size_t size = (std::size_t(Mask) + ... + 0);
+    static constexpr std::array<std::size_t, size> indices = []
+    {
+        constexpr bool mask[] = { Mask..., false };
+        auto result = std::array<std::size_t, size>{ };
+        std::size_t j = 0;
+        for (std::size_t i = 0; i != sizeof...(Mask); ++i)
+        {
+            if (mask[i]) result[j++] = i;
+        }
+        return result;
+    }();
+};
+template <template <typename...> class TypeSeqT, typename SelectionT, typename Js, typename... Ts> struct select_sequence_0_;
+template <template <typename...> class TypeSeqT, typename SelectionT, std::size_t... Js, typename... Ts>
+struct select_sequence_0_<TypeSeqT, SelectionT, std::index_sequence<Js...>, Ts...>
 {
-    using type = Rs;
+    using type = TypeSeqT<typename nth_type_<SelectionT::indices[Js], Ts...>::type...>;
 };
+template <template <typename...> class TypeSeqT, typename SelectionT, typename... Ts>
+struct select_sequence_ : select_sequence_0_<TypeSeqT, SelectionT, std::make_index_sequence<SelectionT::size>, Ts...> { };
+
+    // `unique_sequence_<>` retains the last occurrence of every type.
+template <typename T, typename... Ts> constexpr std::size_t last_type_index_ = detail::find_last_flag({ std::is_same_v<T, Ts>... });
+
+template <typename Is, typename Ts> struct unique_sequence_0_;
+template <std::size_t... Is, template <typename...> class TypeSeqT, typename... Ts>
+struct unique_sequence_0_<std::index_sequence<Is...>, TypeSeqT<Ts...>>
+    : select_sequence_<TypeSeqT, mask_selection_<(last_type_index_<Ts, Ts...> == Is)...>, Ts...> { };
+template <typename Ts> struct unique_sequence_;
+template <template <typename...> class TypeSeqT, typename... Ts>
+struct unique_sequence_<TypeSeqT<Ts...>> : unique_sequence_0_<std::index_sequence_for<Ts...>, TypeSeqT<Ts...>> { };
+
 template <template <typename> class PredT, typename Ts> struct filter_sequence_;
 template <template <typename> class PredT, template <typename...> class TypeSeqT, typename... Ts>
 struct filter_sequence_<PredT, TypeSeqT<Ts...>>
-    : filter_sequence_0_<TypeSeqT<>, PredT, TypeSeqT<Ts...>> { };
+    : select_sequence_<TypeSeqT, mask_selection_<bool(PredT<Ts>::value)...>, Ts...> { };
 
-template <typename... Ts> struct equal_types_;
-template <> struct equal_types_<> : std::false_type { }; // we opt for false because then we don't have to name the common type
-template <typename T> struct equal_types_<T> : std::true_type { using common_type = T; };
-template <typename T0, typename T1, typename... Ts> struct equal_types_<T0, T1, Ts...> : std::false_type { };
-template <typename T01, typename... Ts> struct equal_types_<T01, T01, Ts...> : equal_types_<T01, Ts...> { };
+template <bool AllEqual, typename... Ts> struct equal_types_0_ : std::false_type { }; // we opt for false because then we don't have to name the common type
+template <typename T0, typename... Ts> struct equal_types_0_<true, T0, Ts...> : std::true_type { using common_type = T0; };
+template <typename... Ts> struct equal_types_ : equal_types_0_<false, Ts...> { };
+template <typename T0, typename... Ts> struct equal_types_<T0, Ts...> : equal_types_0_<(std::is_same_v<T0, Ts> && ...), T0, Ts...> { };
 
 
 template <typename T, typename = void> struct default_values { };
@@ -3,15 +3,28 @@
 #define INCLUDED_MAKESHIFT_DETAIL_VARIANT_HPP_
 
 
+#include <bit>          // for countr_zero()
+#include <span>
 #include <array>
+#include <tuple>
+#include <vector>
+#include <limits>
 #include <cstddef>      // for size_t, ptrdiff_t
-#include <utility>      // for integer_sequence<>
+#include <cstdint>      // for int8_t, int16_t, uint8_t, uint16_t, uint32_t, uint64_t, intmax_t, uintmax_t
+#include <algorithm>    // for min(), max(), move()
+#include <utility>      // for integer_sequence<>, forward<>(), swap()
+#include <variant>      // for get<>(), bad_variant_access
 #include <exception>
-#include <type_traits>  // for integral_constant<>, underlying_type<>, declval<>(), remove_const<>, remove_reference<>
+#include <functional>   // for invoke()
+#include <string_view>
+#include <type_traits>  // for integral_constant<>, underlying_type<>, declval<>(), remove_const<>, remove_reference<>, invoke_result<>
 
-#include <gsl-lite/gsl-lite.hpp>  // for type_identity<>
+#include <gsl-lite/gsl-lite.hpp>  // for type_identity<>, gsl_FailFast()
 
-#include <makeshift/constval.hpp>  // for array_constant<>
+#include <makeshift/constval.hpp>  // for array_constant<>, tuple_constant<>
+#include <makeshift/metadata.hpp>  // for members<>()
+
+#include <makeshift/detail/tuple.hpp>  // for apply_impl()
 
 
 namespace makeshift {
@@ -29,6 +42,26 @@ public:
 };
 
 
+    //
+    // Dispatch strategy for `visit()`.
+    //
+enum class visit_dispatch
+{
+        // Use a `switch` statement for small numbers of combinations of alternatives and a table of function pointers otherwise.
+    automatic,
+
+        // Dispatch through a constexpr table of function pointers.
+    jump_table,
+
+        // Dispatch through a generated `switch` statement, which permits the compiler to inline the visitor.
+    switch_statement
+};
+
+
+template <typename ValuesC>
+class constval_variant;
+
+
 namespace detail {
 
 
@@ -43,12 +76,25 @@ struct convertible_to_anything
 };
 #endif // defined(__INTELLISENSE__)
 
+    // `constval_variant_type_<>` names the variant type without requiring it to be complete, which `constval_variant<>` relies on
+    // for arrays with more alternatives than `std::variant<>` can be instantiated with.
+template <template <typename...> class VariantT, typename ValuesC>
+struct constval_variant_type_;
+template <template <typename...> class VariantT, typename T, gsl::type_identity_t<T>... Vs>
+struct constval_variant_type_<VariantT, array_constant<T, Vs...>>
+{
+    using type = VariantT<typename constant_<T, Vs>::type...>; // workaround for VC++ bug, cf. https://developercommunity.visualstudio.com/content/problem/719235/erroneous-c2971-caused-by-using-variadic-by-ref-no.html
+};
+
+template <std::size_t I, typename ValuesC> struct nth_array_constant_;
+template <std::size_t I, typename T, gsl::type_identity_t<T>... Vs> struct nth_array_constant_<I, array_constant<T, Vs...>> { using type = typename nth_type_<I, typename constant_<T, Vs>::type...>::type; };
+
 template <template <typename...> class VariantT, typename ValuesC>
 struct constval_variant_map;
 template <template <typename...> class VariantT, typename T, gsl::type_identity_t<T>... Vs>
 struct constval_variant_map<VariantT, array_constant<T, Vs...>>
 {
-    using type = VariantT<typename constant_<T, Vs>::type...>; // workaround for VC++ bug, cf. https://developercommunity.visualstudio.com/content/problem/719235/erroneous-c2971-caused-by-using-variadic-by-ref-no.html
+    using type = typename constval_variant_type_<VariantT, array_constant<T, Vs...>>::type;
     static constexpr type values[] = {
         type(typename constant_<T, Vs>::type{ })...
     };
@@ -59,60 +105,186 @@ constexpr typename constval_variant_map<VariantT, array_constant<T, Vs...>>::typ
 template <typename T> using can_order_r = decltype(std::declval<T>() < std::declval<T>());
 template <typename T> struct can_order : can_instantiate<can_order_r, T> { };
 
-template <typename CT, std::size_t N>
-constexpr bool are_values_sorted_0(std::true_type /* canOrder */, std::array<CT, N> const& values)
+template <bool IsEnum, typename T> struct has_integral_rep_0_;
+template <typename T> struct has_integral_rep_0_<true, T> : std::true_type { using rep = std::underlying_type_t<T>; };
+template <typename T> struct has_integral_rep_0_<false, T> : std::is_integral<T> { using rep = T; };
+template <typename T> struct has_integral_rep_ : has_integral_rep_0_<std::is_enum<T>::value, T> { };
+template <> struct has_integral_rep_<bool> : std::true_type { using rep = int; };
+
+
+    //
+    // Strategies for finding the index of a runtime value in a constexpr array of values.
+    //
+enum class value_search_strategy
+{
+        // Compare the value with every element; used for small arrays and for values which cannot be ordered.
+    linear,
+
+        // The integral values form an arithmetic progression `v₀ + i⋅d`, so the index can be computed with a division by a constant.
+    arithmetic,
+
+        // The integral values form a geometric progression `v₀⋅2ⁱ`, so the index can be computed from the number of trailing zeros.
+    power_of_two,
+
+        // The integral values span a small range, so the index can be looked up in a dense table.
+    lookup_table,
+
+        // The values are sorted along with their indices at compile time and searched with a branchless binary search.
+    sorted,
+
+        // The values are looked up in a perfect hash table built at compile time, followed by a single comparison.
+    hashed
+};
+
+    // Arrays of at most this many values are searched linearly unless the index can be computed arithmetically.
+constexpr std::size_t max_linear_search_size = 4;
+
+    // Lookup tables are used if the range of values is smaller than `max(min_lookup_table_span, lookup_table_span_factor⋅N)`
+    // and `max_lookup_table_span`.
+constexpr std::size_t min_lookup_table_span = 64;
+constexpr std::size_t lookup_table_span_factor = 4;
+constexpr std::size_t max_lookup_table_span = 4096;
+
+    // Integral values are represented as `std::intmax_t` for searching. The conversion is injective, and we use `std::uintmax_t`
+    // arithmetic to compute distances to avoid overflow.
+template <typename RepT, typename CT, std::size_t N>
+constexpr std::array<std::intmax_t, N> to_search_keys(std::array<CT, N> const& values)
+{
+    auto result = std::array<std::intmax_t, N>{ };
+    for (std::size_t i = 0; i != N; ++i)
+    {
+        result[i] = static_cast<std::intmax_t>(static_cast<RepT>(values[i]));
+    }
+    return result;
+}
+constexpr std::uintmax_t key_distance(std::intmax_t lo, std::intmax_t hi) // expects `lo <= hi`
+{
+    return std::uintmax_t(hi) - std::uintmax_t(lo);
+}
+
+template <std::size_t N>
+constexpr bool is_arithmetic_progression(std::array<std::intmax_t, N> const& keys)
 {
-        // `std::is_sorted()` is not `constexpr`, so we have to reimplement it here
+    if (N < 2 || keys[0] == keys[1]) return false;
+    bool increasing = keys[0] < keys[1];
+    std::uintmax_t step = increasing ? key_distance(keys[0], keys[1]) : key_distance(keys[1], keys[0]);
+    for (std::size_t i = 2; i < N; ++i)
+    {
+        if (keys[i - 1] == keys[i] || (keys[i - 1] < keys[i]) != increasing) return false;
+        std::uintmax_t stepI = increasing ? key_distance(keys[i - 1], keys[i]) : key_distance(keys[i], keys[i - 1]);
+        if (stepI != step) return false;
+    }
+    return true;
+}
+
+template <std::size_t N>
+constexpr bool is_power_of_two_progression(std::array<std::intmax_t, N> const& keys)
+{
+    if (N < 2 || keys[0] <= 0) return false;
     for (std::size_t i = 1; i < N; ++i)
     {
-        if (values[i] < values[i - 1]) return false;
+        if (keys[i - 1] > std::numeric_limits<std::intmax_t>::max() / 2 || keys[i] != keys[i - 1] * 2) return false;
     }
     return true;
 }
-template <typename CT, std::size_t N>
-constexpr bool are_values_sorted_0(std::false_type /* canOrder */, std::array<CT, N> const&)
+
+template <std::size_t N>
+constexpr std::intmax_t min_key(std::array<std::intmax_t, N> const& keys)
 {
-    return false;
+    std::intmax_t result = keys[0];
+    for (std::size_t i = 1; i < N; ++i)
+    {
+        if (keys[i] < result) result = keys[i];
+    }
+    return result;
 }
-template <typename CT, std::size_t N>
-constexpr bool are_values_sorted(std::array<CT, N> const& values)
+template <std::size_t N>
+constexpr std::intmax_t max_key(std::array<std::intmax_t, N> const& keys)
 {
-    return are_values_sorted_0(can_order<CT>{ }, values);
+    std::intmax_t result = keys[0];
+    for (std::size_t i = 1; i < N; ++i)
+    {
+        if (result < keys[i]) result = keys[i];
+    }
+    return result;
 }
 
-template <typename T, typename CT, std::size_t N>
-std::ptrdiff_t search_value_index_2(std::true_type /*sorted*/, T const& value, std::array<CT, N> const& values)
+template <std::size_t N>
+constexpr value_search_strategy select_integral_value_search_strategy(std::array<std::intmax_t, N> const& keys)
 {
-        // binary search
-    std::ptrdiff_t first = 0,
-                   last = N;
-    while (last - first > 1)
+    if (is_arithmetic_progression(keys)) return value_search_strategy::arithmetic;
+    if (is_power_of_two_progression(keys)) return value_search_strategy::power_of_two;
+    if (N <= max_linear_search_size) return value_search_strategy::linear;
+    std::uintmax_t maxSpan = std::min(std::max(min_lookup_table_span, lookup_table_span_factor * N), max_lookup_table_span);
+    if (key_distance(min_key(keys), max_key(keys)) < maxSpan) return value_search_strategy::lookup_table;
+    return value_search_strategy::sorted;
+}
+
+template <value_search_strategy Strategy> using value_search_strategy_constant = std::integral_constant<value_search_strategy, Strategy>;
+
+template <typename CT, std::size_t N>
+struct sorted_values
+{
+    std::array<CT, N> values;
+    std::array<std::ptrdiff_t, N> indices;
+};
+template <typename CT, std::size_t N>
+constexpr sorted_values<CT, N> sort_values(std::array<CT, N> const& values)
+{
+        // Bottom-up merge sort is stable, so the first occurrence of duplicate values is found first, and it needs only
+        // O(N log N) steps, which keeps large arrays within the compiler's limits for constexpr evaluation.
+    auto indices = std::array<std::ptrdiff_t, N>{ };
+    auto merged = std::array<std::ptrdiff_t, N>{ };
+    for (std::size_t i = 0; i != N; ++i)
     {
-        std::ptrdiff_t half = first + (last - first) / 2;
-        if (values[half] < value)
-        {
-            first = half + 1;
-        }
-        else if (value < values[half])
-        {
-            last = half;
-        }
-        else // value == values[half]
+        indices[i] = std::ptrdiff_t(i);
+    }
+    for (std::size_t width = 1; width < N; width *= 2)
+    {
+        for (std::size_t lo = 0; lo < N; lo += 2*width)
         {
-            if (half + 1 == last) return half;
-            last = half + 1;
+            std::size_t mid = std::min(lo + width, N);
+            std::size_t hi = std::min(lo + 2*width, N);
+            std::size_t i = lo;
+            std::size_t j = mid;
+            std::size_t k = lo;
+            while (i != mid && j != hi)
+            {
+                merged[k++] = values[indices[j]] < values[indices[i]] ? indices[j++] : indices[i++];
+            }
+            while (i != mid) merged[k++] = indices[i++];
+            while (j != hi) merged[k++] = indices[j++];
         }
+        std::swap(indices, merged);
     }
-    if (last - first == 1)
+    auto result = sorted_values<CT, N>{ values, indices };
+    for (std::size_t i = 0; i != N; ++i)
     {
-        return values[first] == value ? first : -1;
+        result.values[i] = values[indices[i]];
     }
-    return -1;
+    return result;
+}
+
+template <typename T, typename CT, std::size_t N>
+std::ptrdiff_t search_sorted_values(T const& value, sorted_values<CT, N> const& sorted)
+{
+        // branchless lower bound; the loop has a constant trip count and can be unrolled
+    CT const* base = sorted.values.data();
+    std::size_t n = N;
+    while (n > 1)
+    {
+        std::size_t half = n / 2;
+        base = (base[half - 1] < value) ? base + half : base;
+        n -= half;
+    }
+    base += (*base < value);
+    std::size_t pos = std::size_t(base - sorted.values.data());
+    return pos != N && *base == value ? sorted.indices[pos] : -1;
 }
+
 template <typename T, typename CT, std::size_t N>
-std::ptrdiff_t search_value_index_2(std::false_type /*sorted*/, T const& value, std::array<CT, N> const& values)
+std::ptrdiff_t search_values_linearly(T const& value, std::array<CT, N> const& values)
 {
-        // linear search
     for (std::ptrdiff_t i = 0; i < std::ptrdiff_t(N); ++i)
     {
         if (values[i] == value) return i;
@@ -120,60 +292,372 @@ std::ptrdiff_t search_value_index_2(std::false_type /*sorted*/, T const& value,
     return -1;
 }
 
+template <typename IndexT, std::size_t Span, std::size_t N>
+constexpr std::array<IndexT, Span> make_lookup_table(std::array<std::intmax_t, N> const& keys)
+{
+    auto result = std::array<IndexT, Span>{ };
+    for (std::size_t i = 0; i != Span; ++i)
+    {
+        result[i] = IndexT(-1);
+    }
+    std::intmax_t lo = min_key(keys);
+    for (std::size_t i = N; i-- != 0; ) // in reverse order, so the first occurrence of duplicate values wins
+    {
+        result[key_distance(lo, keys[i])] = IndexT(i);
+    }
+    return result;
+}
+template <std::size_t N>
+using lookup_table_index_t = std::conditional_t<(N <= 127), std::int8_t, std::conditional_t<(N <= 32767), std::int16_t, std::ptrdiff_t>>;
+
+    //
+    // Compile-time perfect hashing for non-integral values. Strings are hashed with FNV-1a, integral values are mixed with the
+    // SplitMix64 finalizer, and tuple-like values and values with reflected members are hashed elementwise.
+    //
+enum class search_key_hash_kind { none, string, integral, tuple, members };
+
+template <typename T>
+constexpr search_key_hash_kind get_search_key_hash_kind(void)
+{
+    if constexpr (std::is_convertible_v<T const&, std::string_view>) return search_key_hash_kind::string;
+    else if constexpr (has_integral_rep_<T>::value) return search_key_hash_kind::integral;
+    else if constexpr (is_tuple_like<T>::value) return search_key_hash_kind::tuple;
+    else if constexpr (std::is_class_v<T>)
+    {
+        if constexpr (metadata::is_available_v<std::remove_cvref_t<decltype(metadata::members<T>())>>) return search_key_hash_kind::members;
+        else return search_key_hash_kind::none;
+    }
+    else return search_key_hash_kind::none;
+}
+
+template <typename T> using search_key_members_t = std::remove_cvref_t<decltype(metadata::members<T>())>;
+template <typename T, typename MemberPtrT> using search_key_member_t = std::remove_cvref_t<decltype(std::declval<T const&>().*std::declval<MemberPtrT>())>;
+
+template <typename T>
+constexpr bool is_search_key_hashable(void);
+template <typename T, std::size_t... Is>
+constexpr bool are_search_key_elements_hashable(std::index_sequence<Is...>)
+{
+    return (is_search_key_hashable<std::remove_cvref_t<std::tuple_element_t<Is, T>>>() && ...);
+}
+template <typename T, std::size_t... Is>
+constexpr bool are_search_key_members_hashable(std::index_sequence<Is...>)
+{
+    return (is_search_key_hashable<search_key_member_t<T, std::tuple_element_t<Is, search_key_members_t<T>>>>() && ...);
+}
+template <typename T>
+constexpr bool is_search_key_hashable(void)
+{
+    constexpr search_key_hash_kind kind = get_search_key_hash_kind<T>();
+    if constexpr (kind == search_key_hash_kind::tuple)
+    {
+        return are_search_key_elements_hashable<T>(std::make_index_sequence<std::tuple_size_v<T>>{ });
+    }
+    else if constexpr (kind == search_key_hash_kind::members)
+    {
+        return are_search_key_members_hashable<T>(std::make_index_sequence<std::tuple_size_v<search_key_members_t<T>>>{ });
+    }
+    else return kind != search_key_hash_kind::none;
+}
+
+    // Runtime values of type `T` can be looked up by hash in an array of values of type `CT` if both are hashed the same way.
+template <typename T, typename CT>
+constexpr bool can_hash_search_keys(void)
+{
+    constexpr search_key_hash_kind kind = get_search_key_hash_kind<CT>();
+    if constexpr (kind == search_key_hash_kind::tuple || kind == search_key_hash_kind::members)
+    {
+        return std::is_same_v<T, CT> && is_search_key_hashable<CT>();
+    }
+    else return kind != search_key_hash_kind::none && get_search_key_hash_kind<T>() == kind;
+}
+
+constexpr std::uint64_t mix_search_key_hash(std::uint64_t h)
+{
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 31;
+    return h;
+}
+constexpr std::uint64_t combine_search_key_hashes(std::uint64_t seed, std::uint64_t h)
+{
+    return mix_search_key_hash(seed ^ (h + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2)));
+}
+
+template <typename T>
+constexpr std::uint64_t hash_search_key(T const& value);
+template <typename T, std::size_t... Is>
+constexpr std::uint64_t hash_search_key_elements(T const& value, std::index_sequence<Is...>)
+{
+    using std::get;
+    std::uint64_t h = 0;
+    ((h = combine_search_key_hashes(h, detail::hash_search_key(get<Is>(value)))), ...);
+    return h;
+}
+template <typename T, std::size_t... Is>
+constexpr std::uint64_t hash_search_key_members(T const& value, std::index_sequence<Is...>)
+{
+    constexpr auto members = metadata::members<T>();
+    std::uint64_t h = 0;
+    ((h = combine_search_key_hashes(h, detail::hash_search_key(value.*std::get<Is>(members)))), ...);
+    return h;
+}
+template <typename T>
+constexpr std::uint64_t hash_search_key(T const& value)
+{
+    constexpr search_key_hash_kind kind = get_search_key_hash_kind<T>();
+    if constexpr (kind == search_key_hash_kind::string)
+    {
+        auto str = std::string_view(value);
+        std::uint64_t h = 0xCBF29CE484222325ull;
+        for (char c : str)
+        {
+            h ^= static_cast<unsigned char>(c);
+            h *= 0x100000001B3ull;
+        }
+        return mix_search_key_hash(h);
+    }
+    else if constexpr (kind == search_key_hash_kind::integral)
+    {
+        return mix_search_key_hash(std::uint64_t(static_cast<std::intmax_t>(static_cast<typename has_integral_rep_<T>::rep>(value))));
+    }
+    else if constexpr (kind == search_key_hash_kind::tuple)
+    {
+        return detail::hash_search_key_elements(value, std::make_index_sequence<std::tuple_size_v<T>>{ });
+    }
+    else // kind == search_key_hash_kind::members
+    {
+        return detail::hash_search_key_members(value, std::make_index_sequence<std::tuple_size_v<search_key_members_t<T>>>{ });
+    }
+}
+
+template <typename CT, std::size_t N>
+constexpr std::array<std::uint64_t, N> hash_search_keys(std::array<CT, N> const& values)
+{
+    auto result = std::array<std::uint64_t, N>{ };
+    for (std::size_t i = 0; i != N; ++i)
+    {
+        result[i] = detail::hash_search_key(values[i]);
+    }
+    return result;
+}
+
+    // Number of slot probes tried in total before perfect hashing is given up. This bounds the work of constant evaluation if no
+    // suitable displacements can be found.
+constexpr std::size_t max_perfect_hash_probes = std::size_t(1) << 16;
+
+    //
+    // Perfect hash table built with the "hash and displace" method: keys are distributed into buckets by the upper half of the
+    // hash, and for every bucket a displacement is chosen such that all keys in the bucket map to distinct free slots. Looking up
+    // a key thus takes one hash computation, two table lookups, and one comparison to verify the key.
+    //
+template <std::size_t N>
+struct perfect_hash_table
+{
+    static constexpr std::size_t num_buckets = std::bit_ceil(std::max<std::size_t>(N / 2, 1));
+    static constexpr std::size_t num_slots = std::bit_ceil(std::max<std::size_t>(2 * N, 1));
+
+    bool valid = false;
+    std::array<std::uint32_t, num_buckets> displacements{ };
+    std::array<lookup_table_index_t<N>, num_slots> slots{ };
+
+    static constexpr std::size_t bucket(std::uint64_t hash)
+    {
+        return std::size_t(hash >> 32) & (num_buckets - 1);
+    }
+    static constexpr std::size_t slot(std::uint64_t hash, std::uint32_t displacement)
+    {
+        return std::size_t(mix_search_key_hash(hash + displacement * 0x9E3779B97F4A7C15ull)) & (num_slots - 1);
+    }
+
+    constexpr std::ptrdiff_t find(std::uint64_t hash) const
+    {
+        return slots[slot(hash, displacements[bucket(hash)])];
+    }
+};
+template <std::size_t N>
+constexpr perfect_hash_table<N> make_perfect_hash_table(std::array<std::uint64_t, N> const& hashes)
+{
+    using table = perfect_hash_table<N>;
+
+    auto result = table{ };
+    for (auto& s : result.slots)
+    {
+        s = -1;
+    }
+    auto bucketSizes = std::array<std::size_t, table::num_buckets>{ };
+    for (std::size_t i = 0; i != N; ++i)
+    {
+        ++bucketSizes[table::bucket(hashes[i])];
+    }
+
+        // Place buckets in order of decreasing size.
+    auto bucketPlaced = std::array<bool, table::num_buckets>{ };
+    auto bucketKeys = std::array<std::size_t, N>{ };
+    auto bucketSlots = std::array<std::size_t, N>{ };
+    std::size_t probes = 0;
+    for (std::size_t k = 0; k != table::num_buckets; ++k)
+    {
+        std::size_t b = 0;
+        while (bucketPlaced[b]) ++b;
+        for (std::size_t c = b + 1; c != table::num_buckets; ++c)
+        {
+            if (!bucketPlaced[c] && bucketSizes[c] > bucketSizes[b]) b = c;
+        }
+        bucketPlaced[b] = true;
+        if (bucketSizes[b] == 0) break;
+
+            // Keys with identical hashes (e.g. duplicate values) always share a bucket and can never be told apart, so we give up
+            // before searching for a displacement.
+        std::size_t n = 0;
+        for (std::size_t i = 0; i != N; ++i)
+        {
+            if (table::bucket(hashes[i]) != b) continue;
+            for (std::size_t j = 0; j != n; ++j)
+            {
+                if (hashes[bucketKeys[j]] == hashes[i]) return result;
+            }
+            bucketKeys[n++] = i;
+        }
+
+        std::uint32_t d = 0;
+        for (bool found = false; !found; )
+        {
+            found = true;
+            for (std::size_t m = 0; m != n && found; ++m)
+            {
+                if (probes++ == max_perfect_hash_probes) return result;
+                std::size_t s = table::slot(hashes[bucketKeys[m]], d);
+                found = result.slots[s] == -1;
+                for (std::size_t j = 0; j != m && found; ++j)
+                {
+                    found = bucketSlots[j] != s;
+                }
+                bucketSlots[m] = s;
+            }
+            if (!found) ++d;
+        }
+        result.displacements[b] = d;
+        for (std::size_t m = 0; m != n; ++m)
+        {
+            result.slots[bucketSlots[m]] = lookup_table_index_t<N>(bucketKeys[m]);
+        }
+    }
+    result.valid = true;
+    return result;
+}
+
+template <typename ValuesC>
+struct perfect_hash_
+{
+    static constexpr auto table = make_perfect_hash_table(hash_search_keys(ValuesC::value));
+};
+
+template <typename T, typename ValuesC>
+constexpr value_search_strategy select_value_search_strategy(ValuesC)
+{
+    using CT = typename ValuesC::element_type;
+
+    if constexpr (ValuesC::value.size() <= max_linear_search_size) return value_search_strategy::linear;
+    else
+    {
+        if constexpr (can_hash_search_keys<std::remove_cvref_t<T>, CT>())
+        {
+            if (perfect_hash_<ValuesC>::table.valid) return value_search_strategy::hashed;
+        }
+        return can_order<CT>::value ? value_search_strategy::sorted : value_search_strategy::linear;
+    }
+}
+
 template <typename RepT, typename T, typename ValuesC>
-std::ptrdiff_t search_value_index_1(std::true_type /*bool||enum||integral && contiguous*/, T const& value, ValuesC valuesC)
+std::ptrdiff_t search_value_index_1(value_search_strategy_constant<value_search_strategy::linear>, T const& value, ValuesC valuesC)
 {
-    constexpr auto const& values = valuesC.value;
-    constexpr auto r0 = static_cast<RepT>(values[0]);
-    auto r = static_cast<RepT>(value);
-    if (r < r0 || std::size_t(r - r0) >= values.size()) return -1;
-    return r - r0;
+    return search_values_linearly(value, valuesC.value);
 }
 template <typename RepT, typename T, typename ValuesC>
-std::ptrdiff_t search_value_index_1(std::false_type /*bool||enum||integral && contiguous*/, T const& value, ValuesC valuesC)
+std::ptrdiff_t search_value_index_1(value_search_strategy_constant<value_search_strategy::arithmetic>, T const& value, ValuesC valuesC)
 {
-    constexpr bool sorted = are_values_sorted(valuesC.value); // TODO: perhaps we can just sort values for the index lookup
-    return search_value_index_2(std::integral_constant<bool, sorted>{ }, value, valuesC.value);
+    constexpr auto keys = to_search_keys<RepT>(valuesC.value);
+    constexpr std::size_t n = keys.size();
+    constexpr bool increasing = keys[0] < keys[1];
+    constexpr std::intmax_t first = increasing ? keys[0] : keys[n - 1];
+    constexpr std::uintmax_t step = increasing ? key_distance(keys[0], keys[1]) : key_distance(keys[1], keys[0]);
+
+    auto key = static_cast<std::intmax_t>(static_cast<RepT>(value));
+    if (key < first) return -1;
+    std::uintmax_t offset = key_distance(first, key);
+    std::uintmax_t i = offset / step;
+    if (i >= n || offset % step != 0) return -1;
+    return increasing ? std::ptrdiff_t(i) : std::ptrdiff_t(n - 1 - i);
 }
+template <typename RepT, typename T, typename ValuesC>
+std::ptrdiff_t search_value_index_1(value_search_strategy_constant<value_search_strategy::power_of_two>, T const& value, ValuesC valuesC)
+{
+    constexpr auto keys = to_search_keys<RepT>(valuesC.value);
+    constexpr std::ptrdiff_t n = std::ptrdiff_t(keys.size());
+    constexpr std::ptrdiff_t firstShift = std::countr_zero(std::uintmax_t(keys[0]));
 
-template <typename RepT, typename CT, std::size_t N>
-constexpr bool are_values_contiguous(std::array<CT, N> const& values)
+    auto key = static_cast<std::intmax_t>(static_cast<RepT>(value));
+    if (key <= 0) return -1;
+    std::ptrdiff_t i = std::countr_zero(std::uintmax_t(key)) - firstShift;
+    if (i < 0 || i >= n) return -1;
+    return (std::uintmax_t(keys[0]) << i) == std::uintmax_t(key) ? i : -1;
+}
+template <typename RepT, typename T, typename ValuesC>
+std::ptrdiff_t search_value_index_1(value_search_strategy_constant<value_search_strategy::lookup_table>, T const& value, ValuesC valuesC)
 {
-    static_assert(N > 0, "overload resolution failed");
+    static constexpr auto keys = to_search_keys<RepT>(valuesC.value);
+    static constexpr std::intmax_t lo = min_key(keys);
+    static constexpr std::size_t span = std::size_t(key_distance(lo, max_key(keys))) + 1;
+    static constexpr auto table = make_lookup_table<lookup_table_index_t<keys.size()>, span>(keys);
 
-    auto r = static_cast<RepT>(values[0]);
-    for (std::size_t i = 1; i < N; ++i)
+    auto key = static_cast<std::intmax_t>(static_cast<RepT>(value));
+    if (key < lo) return -1;
+    std::uintmax_t offset = key_distance(lo, key);
+    if (offset >= span) return -1;
+    return table[offset];
+}
+template <typename RepT, typename T, typename ValuesC>
+std::ptrdiff_t search_value_index_1(value_search_strategy_constant<value_search_strategy::sorted>, T const& value, ValuesC valuesC)
+{
+    if constexpr (std::is_void_v<RepT>)
     {
-        auto rNext = static_cast<RepT>(values[i]);
-        if (rNext != r + 1) return false;
-        r = rNext;
+        static constexpr auto sorted = sort_values(valuesC.value);
+        return search_sorted_values(value, sorted);
+    }
+    else
+    {
+        static constexpr auto sorted = sort_values(to_search_keys<RepT>(valuesC.value));
+        return search_sorted_values(static_cast<std::intmax_t>(static_cast<RepT>(value)), sorted);
     }
-    return true;
 }
-template <typename RepT, typename CT>
-constexpr bool are_values_contiguous(std::array<CT, 0> const& /*values*/)
+template <typename RepT, typename T, typename ValuesC>
+std::ptrdiff_t search_value_index_1(value_search_strategy_constant<value_search_strategy::hashed>, T const& value, ValuesC valuesC)
 {
-    return false;
+    constexpr auto const& values = valuesC.value;
+    std::ptrdiff_t i = perfect_hash_<ValuesC>::table.find(detail::hash_search_key(value));
+    return i >= 0 && values[i] == value ? i : -1;
 }
 
 template <typename RepT, typename T, typename ValuesC>
 std::ptrdiff_t search_value_index_0(std::true_type /*bool||enum||integral*/, T const& value, ValuesC valuesC)
 {
-    constexpr bool contiguous = are_values_contiguous<RepT>(valuesC.value); // implies that at least one element exists
-    return search_value_index_1<RepT>(std::integral_constant<bool, contiguous>{ }, value, valuesC);
+    constexpr value_search_strategy strategy = select_integral_value_search_strategy(to_search_keys<RepT>(valuesC.value));
+    return search_value_index_1<RepT>(value_search_strategy_constant<strategy>{ }, value, valuesC);
 }
-template <typename T, typename ValuesC>
+template <typename RepT, typename T, typename ValuesC>
 std::ptrdiff_t search_value_index_0(std::false_type /*bool||enum||integral*/, T const& value, ValuesC valuesC)
 {
-    return search_value_index_1<T>(std::false_type{ }, value, valuesC);
+    constexpr value_search_strategy strategy = select_value_search_strategy<T>(valuesC);
+    return search_value_index_1<void>(value_search_strategy_constant<strategy>{ }, value, valuesC);
 }
 
-template <bool IsEnum, typename T> struct has_integral_rep_0_;
-template <typename T> struct has_integral_rep_0_<true, T> : std::true_type { using rep = std::underlying_type_t<T>; };
-template <typename T> struct has_integral_rep_0_<false, T> : std::is_integral<T> { using rep = T; };
-template <typename T> struct has_integral_rep_ : has_integral_rep_0_<std::is_enum<T>::value, T> { };
-template <> struct has_integral_rep_<bool> : std::true_type { using rep = int; };
-
+    //
+    // Returns the index of the given value in the constexpr array of values, or -1 if the value is not found. The search strategy
+    // is selected at compile time based on the shape of the set of values.
+    //
 template <typename T, typename ValuesC>
 std::ptrdiff_t search_value_index(T const& value, ValuesC valuesC)
 {
@@ -204,6 +688,252 @@ template <typename ShapeT> using compute_strides_t = typename compute_strides_<S
 template <typename ShapeT> struct compute_size_;
 template <std::ptrdiff_t... Is> struct compute_size_<std::integer_sequence<std::ptrdiff_t, Is...>> : std::integral_constant<std::ptrdiff_t, (Is * ... * 1)> { };
 
+    // Dispatch tables with at most this many entries are implemented with a `switch` statement by default.
+constexpr std::size_t max_switch_dispatch_size = 16;
+
+    // Calls `func(std::integral_constant<std::size_t, I>{ })` for `I == index`, either through a table of function pointers
+    // or through a generated `switch` statement. The `switch` statement has a fixed number of cases; larger index ranges are
+    // handled by chaining several `switch` statements.
+template <typename R, std::size_t N, typename F>
+struct index_dispatch_
+{
+    template <std::size_t I>
+    static constexpr R invoke(F& func)
+    {
+        return func(std::integral_constant<std::size_t, I>{ });
+    }
+
+    using function_pointer = R (*)(F&);
+
+    template <std::size_t... Is>
+    static constexpr std::array<function_pointer, N> make_table(std::index_sequence<Is...>) noexcept
+    {
+        return { &invoke<Is>... };
+    }
+    static constexpr std::array<function_pointer, N> table = make_table(std::make_index_sequence<N>{ });
+
+    template <std::size_t Base>
+    static constexpr R invoke_switch(std::size_t index, F& func)
+    {
+        gsl_DISABLE_MSVC_WARNINGS(4702)  // unreachable code
+
+#define MAKESHIFT_DETAIL_DISPATCH_CASE(I) \
+        case I: if constexpr (Base + I < N) { return invoke<Base + I>(func); } else { break; }
+
+        switch (index)
+        {
+        MAKESHIFT_DETAIL_DISPATCH_CASE(0)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(1)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(2)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(3)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(4)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(5)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(6)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(7)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(8)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(9)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(10)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(11)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(12)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(13)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(14)
+        MAKESHIFT_DETAIL_DISPATCH_CASE(15)
+        default: break;
+        }
+
+#undef MAKESHIFT_DETAIL_DISPATCH_CASE
+
+        if constexpr (Base + max_switch_dispatch_size < N)
+        {
+            return invoke_switch<Base + max_switch_dispatch_size>(index - max_switch_dispatch_size, func);
+        }
+        else
+        {
+            gsl_FailFast();  // index out of range
+        }
+
+        gsl_RESTORE_MSVC_WARNINGS()
+    }
+};
+template <typename R, std::size_t N, bool UseSwitch, typename F>
+constexpr R
+dispatch_index(std::size_t index, F& func)
+{
+    static_assert(max_switch_dispatch_size == 16, "number of cases in `index_dispatch_<>::invoke_switch()` must match");
+
+    if constexpr (UseSwitch)
+    {
+        return index_dispatch_<R, N, F>::template invoke_switch<0>(index, func);
+    }
+    else
+    {
+        return index_dispatch_<R, N, F>::table[index](func);
+    }
+}
+
+    // Index type of `constval_variant<>`.
+template <std::size_t N>
+using constval_variant_index_t = std::conditional_t<(N <= 256), std::uint8_t, std::conditional_t<(N <= 65536), std::uint16_t, std::uint32_t>>;
+
+    // `visit()` accepts `std::variant<>` and `constval_variant<>` arguments. Like `std::visit()`, it also accepts arguments of
+    // types derived from `std::variant<>`, which are mapped to their `std::variant<>` base.
+template <typename... Ts> constexpr std::variant<Ts...>& as_variant(std::variant<Ts...>& variant) noexcept { return variant; }
+template <typename... Ts> constexpr std::variant<Ts...> const& as_variant(std::variant<Ts...> const& variant) noexcept { return variant; }
+template <typename... Ts> constexpr std::variant<Ts...>&& as_variant(std::variant<Ts...>&& variant) noexcept { return std::move(variant); }
+template <typename... Ts> constexpr std::variant<Ts...> const&& as_variant(std::variant<Ts...> const&& variant) noexcept { return std::move(variant); }
+template <typename ValuesC> constexpr constval_variant<ValuesC> as_variant(constval_variant<ValuesC> variant) noexcept { return variant; }
+template <typename V> using as_variant_t = std::remove_cvref_t<decltype(detail::as_variant(std::declval<V>()))>;
+
+template <typename V> struct variant_size_ : std::variant_size<V> { };
+template <typename ValuesC> struct variant_size_<constval_variant<ValuesC>> : std::integral_constant<std::size_t, ValuesC::value.size()> { };
+
+template <typename V> struct constval_variant_values_ { };
+template <typename ValuesC> struct constval_variant_values_<constval_variant<ValuesC>> { using type = ValuesC; };
+template <typename V> using constval_variant_values_t = typename constval_variant_values_<V>::type;
+
+template <std::size_t I, typename V>
+constexpr decltype(auto)
+variant_get(V&& variant)
+{
+    if constexpr (can_instantiate_v<constval_variant_values_t, std::remove_cvref_t<V>>)
+    {
+            // Do not look up `get<>()` with ADL here: checking the `std::get<>()` overloads for `std::variant<>` would require
+            // the variant type to be complete.
+        if (variant.index() != I) throw std::bad_variant_access{ };
+        return typename nth_array_constant_<I, constval_variant_values_t<std::remove_cvref_t<V>>>::type{ };
+    }
+    else
+    {
+        using std::get;
+        return get<I>(std::forward<V>(variant));
+    }
+}
+
+template <typename V>
+constexpr bool
+is_variant_valueless(V const& variant)
+{
+    return variant.valueless_by_exception();
+}
+template <typename ValuesC>
+constexpr bool
+is_variant_valueless(constval_variant<ValuesC> const&)
+{
+    return false;
+}
+
+template <typename F, typename... Vs> struct visit_result_ { using type = std::invoke_result_t<F, decltype(detail::variant_get<0>(detail::as_variant(std::declval<Vs>())))...>; };
+template <typename F, typename... Vs> using visit_result_t = typename visit_result_<F, Vs...>::type;
+
+    // Computes the linear index of the combination of alternatives held by the given variants.
+template <std::ptrdiff_t... Strides, typename... Vs>
+constexpr std::size_t
+variant_linear_index(std::integer_sequence<std::ptrdiff_t, Strides...>, Vs const&... args)
+{
+    if ((detail::is_variant_valueless(args) || ...))
+    {
+        throw std::bad_variant_access{ };
+    }
+    return ((args.index()*std::size_t(Strides)) + ... + std::size_t(0));
+}
+
+    // Visits the variants by computing the linear index of the combination of alternatives held and dispatching to the
+    // corresponding specialization. If `CheckResult` is true, all specializations must return `R`, as required by `std::visit()`;
+    // otherwise, results are converted to `R`, as with `std::visit<R>()`.
+template <typename R, bool CheckResult, bool UseSwitch, std::ptrdiff_t... Dims, std::ptrdiff_t... Strides, typename F, typename... Vs>
+constexpr R
+visit_impl(std::integer_sequence<std::ptrdiff_t, Dims...>, std::integer_sequence<std::ptrdiff_t, Strides...> strides, F&& func, Vs&&... args)
+{
+    constexpr std::size_t numOptions = std::size_t((Dims * ... * 1));
+
+    std::size_t index = detail::variant_linear_index(strides, args...);
+    auto invokeAlternatives = [&func, &args...]
+    (auto indexC) -> R
+    {
+        constexpr std::size_t I = decltype(indexC)::value;
+        if constexpr (CheckResult)
+        {
+            static_assert(std::is_same<decltype(std::invoke(std::forward<F>(func), detail::variant_get<(I / std::size_t(Strides)) % std::size_t(Dims)>(std::forward<Vs>(args))...)), R>::value,
+                "visitor must return the same type for all combinations of alternatives");
+        }
+        if constexpr (std::is_void<R>::value)
+        {
+            std::invoke(std::forward<F>(func), detail::variant_get<(I / std::size_t(Strides)) % std::size_t(Dims)>(std::forward<Vs>(args))...);
+        }
+        else
+        {
+            return std::invoke(std::forward<F>(func), detail::variant_get<(I / std::size_t(Strides)) % std::size_t(Dims)>(std::forward<Vs>(args))...);
+        }
+    };
+    return detail::dispatch_index<R, numOptions, UseSwitch>(index, invokeAlternatives);
+}
+template <typename R, bool CheckResult, visit_dispatch Dispatch, typename F, typename... Vs>
+constexpr R
+visit(F&& func, Vs&&... args)
+{
+    using Shape = std::integer_sequence<std::ptrdiff_t, std::ptrdiff_t(variant_size_<as_variant_t<Vs>>::value)...>;
+    constexpr bool useSwitch = Dispatch == visit_dispatch::switch_statement
+        || (Dispatch == visit_dispatch::automatic && std::size_t(compute_size_<Shape>::value) <= max_switch_dispatch_size);
+    return detail::visit_impl<R, CheckResult, useSwitch>(Shape{ }, compute_strides_t<Shape>{ }, std::forward<F>(func), detail::as_variant(std::forward<Vs>(args))...);
+}
+
+template <typename V, std::size_t I> using variant_alternative_type_t = std::remove_cvref_t<decltype(detail::variant_get<I>(std::declval<V>()))>;
+
+    // Groups the items by the combination of alternatives of the variants returned by the projections with a stable counting
+    // sort, then calls `func(batch, alternatives...)` once for every non-empty group.
+template <bool UseSwitch, std::ptrdiff_t... Dims, std::ptrdiff_t... Strides, typename F, typename T, typename... ProjectionsT>
+void
+visit_batched_impl(std::integer_sequence<std::ptrdiff_t, Dims...>, std::integer_sequence<std::ptrdiff_t, Strides...> strides, F& func,
+    std::span<T> items, ProjectionsT&... projections)
+{
+    constexpr std::size_t numOptions = std::size_t((Dims * ... * 1));
+    static_assert(!std::is_const_v<T>, "visit_batched() reorders the items, which therefore must not be const");
+
+    std::size_t n = items.size();
+    auto keys = std::vector<std::size_t>(n);
+    auto offsets = std::vector<std::size_t>(numOptions + 1);
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        std::size_t key = detail::variant_linear_index(strides, std::invoke(projections, items[i])...);
+        keys[i] = key;
+        ++offsets[key + 1];
+    }
+    for (std::size_t k = 0; k != numOptions; ++k)
+    {
+        offsets[k + 1] += offsets[k];
+    }
+
+        // Reorder the items by moving them to a buffer in sorted order and back.
+    auto order = std::vector<std::size_t>(n);
+    auto next = std::vector<std::size_t>(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        order[next[keys[i]]++] = i;
+    }
+    auto buffer = std::vector<T>{ };
+    buffer.reserve(n);
+    for (std::size_t j = 0; j != n; ++j)
+    {
+        buffer.push_back(std::move(items[order[j]]));
+    }
+    std::move(buffer.begin(), buffer.end(), items.begin());
+
+    auto invokeBatch = [&func, items, &offsets]
+    (auto indexC)
+    {
+        constexpr std::size_t I = decltype(indexC)::value;
+        std::invoke(func, items.subspan(offsets[I], offsets[I + 1] - offsets[I]),
+            variant_alternative_type_t<std::invoke_result_t<ProjectionsT&, T&>, (I / std::size_t(Strides)) % std::size_t(Dims)>{ }...);
+    };
+    for (std::size_t k = 0; k != numOptions; ++k)
+    {
+        if (offsets[k + 1] != offsets[k])
+        {
+            detail::dispatch_index<void, numOptions, UseSwitch>(k, invokeBatch);
+        }
+    }
+}
+
 template <typename ShapeT, typename StridesT, typename F, typename... ArgSeqsT>
 struct variant_transform_result_1_;
 template <std::ptrdiff_t... Dims, std::ptrdiff_t... Strides, typename F, typename... ArgSeqsT>
@@ -247,24 +977,24 @@ struct variant_transform_result_
 template <template <typename...> class VariantT, typename F, typename... Vs>
 using variant_transform_result = typename variant_transform_result_<VariantT, F, Vs...>::type;
 
-template <template <typename...> class VariantT, typename Rs, typename Vs>
+    // Concatenates the alternatives of a sequence of variants with a fold expression rather than recursing once per variant.
+template <typename... Ts> struct type_concat_ { };
+template <typename... Ts, typename... Us> type_concat_<Ts..., Us...> operator +(type_concat_<Ts...>, type_concat_<Us...>);
+template <template <typename...> class VariantT, typename V> struct variant_type_concat_;
+template <template <typename...> class VariantT, typename... Ts> struct variant_type_concat_<VariantT, VariantT<Ts...>> { using type = type_concat_<Ts...>; };
+template <template <typename...> class VariantT, typename Vs>
 struct flatten_variant_;
-template <template <typename...> class VariantT, typename Rs>
-struct flatten_variant_<VariantT, Rs, type_seq_<>>
-{
-    using type = Rs;
-};
-template <template <typename...> class VariantT, typename... Rs, typename... V0Ts, typename... Vs>
-struct flatten_variant_<VariantT, type_seq_<Rs...>, type_seq_<VariantT<V0Ts...>, Vs...>>
-    : flatten_variant_<VariantT, type_seq_<Rs..., V0Ts...>, type_seq_<Vs...>>
+template <template <typename...> class VariantT, typename... Vs>
+struct flatten_variant_<VariantT, type_seq_<Vs...>>
 {
+    using type = typename instantiate_<type_seq_, decltype((type_concat_<>{ } + ... + typename variant_type_concat_<VariantT, Vs>::type{ }))>::type;
 };
 
 template <template <typename...> class VariantT, typename F, typename... Vs>
 struct variant_transform_many_result_
 {
     using result_seq_ = typename variant_transform_result_0_<VariantT, F, Vs...>::type;
-    using flat_result_seq_ = typename flatten_variant_<VariantT, type_seq_<>, result_seq_>::type;
+    using flat_result_seq_ = typename flatten_variant_<VariantT, result_seq_>::type;
     using unique_result_seq_ = typename unique_sequence_<flat_result_seq_>::type;
     using type = typename instantiate_<VariantT, unique_result_seq_>::type;
 };
@@ -272,6 +1002,93 @@ template <template <typename...> class VariantT, typename F, typename... Vs>
 using variant_transform_many_result = typename variant_transform_many_result_<VariantT, F, Vs...>::type;
 
 
+    // Maps every combination of values of the given constexpr arrays to a tuple of constvals; the combinations are enumerated
+    // in the order of the linear index defined by `compute_strides_t<>`.
+template <template <typename...> class VariantT, typename ShapeT, typename StridesT, typename IndicesT, typename... ValuesCs>
+struct constval_tuple_variant_map_0_;
+template <template <typename...> class VariantT, std::ptrdiff_t... Dims, std::ptrdiff_t... Strides, std::size_t... Is, typename... ValuesCs>
+struct constval_tuple_variant_map_0_<VariantT, std::integer_sequence<std::ptrdiff_t, Dims...>, std::integer_sequence<std::ptrdiff_t, Strides...>, std::index_sequence<Is...>, ValuesCs...>
+{
+    template <std::size_t I>
+    using tuple_for_idx = std::tuple<typename nth_array_constant_<(I / std::size_t(Strides)) % std::size_t(Dims), ValuesCs>::type...>;
+
+    using type = VariantT<tuple_for_idx<Is>...>;
+    static constexpr type values[] = {
+        type(tuple_for_idx<Is>{ })...
+    };
+};
+template <template <typename...> class VariantT, std::ptrdiff_t... Dims, std::ptrdiff_t... Strides, std::size_t... Is, typename... ValuesCs>
+constexpr typename constval_tuple_variant_map_0_<VariantT, std::integer_sequence<std::ptrdiff_t, Dims...>, std::integer_sequence<std::ptrdiff_t, Strides...>, std::index_sequence<Is...>, ValuesCs...>::type
+constval_tuple_variant_map_0_<VariantT, std::integer_sequence<std::ptrdiff_t, Dims...>, std::integer_sequence<std::ptrdiff_t, Strides...>, std::index_sequence<Is...>, ValuesCs...>::values[];
+
+template <template <typename...> class VariantT, typename... ValuesCs>
+struct constval_tuple_variant_map
+{
+    using shape = std::integer_sequence<std::ptrdiff_t, std::ptrdiff_t(std::tuple_size<ValuesCs>::value)...>;
+    using strides = compute_strides_t<shape>;
+    using map = constval_tuple_variant_map_0_<VariantT, shape, strides, std::make_index_sequence<std::size_t(compute_size_<shape>::value)>, ValuesCs...>;
+    using type = typename map::type;
+};
+
+    // Looks up the indices of all values and computes their linear index with mixed-radix arithmetic. Returns -1 if one of the
+    // values is not among the values in the corresponding array.
+template <std::ptrdiff_t... Strides, typename ValuesT, typename ValuesCsT, std::size_t... Is>
+constexpr std::ptrdiff_t
+search_value_linear_index(std::integer_sequence<std::ptrdiff_t, Strides...>, ValuesT const& values, ValuesCsT const& valuesCs, std::index_sequence<Is...>)
+{
+    std::ptrdiff_t indices[] = { detail::search_value_index(std::get<Is>(values), std::get<Is>(valuesCs))... };
+    std::ptrdiff_t result = 0;
+    bool found = ((indices[Is] >= 0) && ...);
+    if (!found) return -1;
+    ((result += indices[Is]*Strides), ...);
+    return result;
+}
+
+template <typename ValuesCsT> struct expand_all_map_;
+template <typename... ValuesCs> struct expand_all_map_<std::tuple<ValuesCs const&...>> : constval_tuple_variant_map<std::variant, ValuesCs...> { };
+
+template <typename TupleT, std::size_t Offset, std::size_t... Is>
+constexpr auto
+tuple_slice(TupleT const& tuple, std::index_sequence<Is...>)
+{
+    return std::forward_as_tuple(std::get<Offset + Is>(tuple)...);
+}
+
+template <typename... Args>
+constexpr auto
+split_expand_all_args(Args const&... args)
+{
+    static_assert(sizeof...(Args) % 2 == 0, "expected a list of values followed by a list of the same number of constexpr arrays");
+    constexpr std::size_t numValues = sizeof...(Args) / 2;
+
+    auto argTuple = std::forward_as_tuple(args...);
+    return std::pair(
+        detail::tuple_slice<decltype(argTuple), 0>(argTuple, std::make_index_sequence<numValues>{ }),
+        detail::tuple_slice<decltype(argTuple), numValues>(argTuple, std::make_index_sequence<numValues>{ }));
+}
+
+
+template <typename T> struct is_unpackable_ : std::false_type { };
+template <typename... Ts> struct is_unpackable_<std::tuple<Ts...>> : std::true_type { };
+template <typename... Cs> struct is_unpackable_<tuple_constant<Cs...>> : std::true_type { };
+
+    // Calls the functor with the elements of the argument if it is a tuple or a tuple constval, and with the argument itself
+    // otherwise.
+template <typename F, typename T>
+constexpr decltype(auto)
+invoke_unpacked(F& func, T const& arg)
+{
+    if constexpr (is_unpackable_<T>::value)
+    {
+        return detail::apply_impl(func, arg);
+    }
+    else
+    {
+        return std::invoke(func, arg);
+    }
+}
+
+
 } // namespace detail
 
 } // namespace makeshift
@@ -90,6 +90,17 @@ get(tuple_index_t) noexcept
 }
 
 
+    // Defined in <makeshift/detail/algorithm.hpp>.
+template <typename F, typename N, typename... Rs>
+class transform_range;
+template <typename IndexR, typename DataR, std::ptrdiff_t PrefetchDistance>
+class indirect_range;
+    // Tag for `strided_range<>` views of whole elements rather than of one of their data members.
+struct no_member { };
+template <typename T, typename N, typename S, typename M = no_member>
+class strided_range;
+
+
 template <typename R, typename = void> struct has_data : std::false_type { };
 template <typename R> struct has_data<R, std::void_t<decltype(std::data(std::declval<R>()))>> : std::true_type { };
 
@@ -103,7 +114,10 @@ enum class iterator_mode
     index,
     range_index,
     tuple_element,
-    tuple_index
+    tuple_index,
+    transform,
+    indirect,
+    strided
 };
 
 /*
@@ -121,6 +135,10 @@ range_for                           template_for
 range_transform_reduce              template_transform_reduce
 range_reduce                        template_reduce
 range_count_if
+range_inclusive_scan
+range_exclusive_scan
+range_copy_if
+range_remove_if
 
 range_all_of                    template_all_of
 range_any_of                    template_any_of
@@ -130,6 +148,9 @@ range_none_of                   template_none_of
                                 array_cat           [tuple_cat]
 
 range_zip
+range_transform
+indirect_range
+strided_range
 
 */
 
@@ -218,6 +239,8 @@ constexpr decltype(auto) range_end(R&& range)
 template <typename R> struct range_iterator_category_{ using type = typename std::iterator_traits<decltype(detail::range_begin(std::declval<R>()))>::iterator_category; };
 template <> struct range_iterator_category_<range_index_t> { using type = std::random_access_iterator_tag; };
 template <> struct range_iterator_category_<tuple_index_t> { using type = std::input_iterator_tag; }; // TODO: ?
+template <typename IndexR, typename DataR, std::ptrdiff_t PrefetchDistance> struct range_iterator_category_<indirect_range<IndexR, DataR, PrefetchDistance>> { using type = common_iterator_tag<typename range_iterator_category_<std::decay_t<IndexR>>::type, std::random_access_iterator_tag>; };
+template <typename T, typename N, typename S, typename M> struct range_iterator_category_<strided_range<T, N, S, M>> { using type = std::random_access_iterator_tag; };
 template <typename R> using range_iterator_category_t = typename range_iterator_category_<R>::type;
 
 template <typename It, typename = void> struct range_iterator_concept_1_ { using type = typename std::iterator_traits<It>::iterator_category; };
@@ -227,6 +250,8 @@ template <typename It> struct range_iterator_concept_0_<It, std::void_t<typename
 template <typename R> struct range_iterator_concept_ : range_iterator_concept_0_<decltype(detail::range_begin(std::declval<R>()))> { };
 template <> struct range_iterator_concept_<range_index_t> : range_iterator_category_<range_index_t> { };
 template <> struct range_iterator_concept_<tuple_index_t> : range_iterator_category_<tuple_index_t> { };
+template <typename IndexR, typename DataR, std::ptrdiff_t PrefetchDistance> struct range_iterator_concept_<indirect_range<IndexR, DataR, PrefetchDistance>> { using type = common_iterator_tag<typename range_iterator_concept_<std::decay_t<IndexR>>::type, std::random_access_iterator_tag>; };
+template <typename T, typename N, typename S, typename M> struct range_iterator_concept_<strided_range<T, N, S, M>> : range_iterator_category_<strided_range<T, N, S, M>> { };
 template <typename R> using range_iterator_concept_t = typename range_iterator_concept_<R>::type;
 
 template <bool HasData, bool HasSize> struct range_iterator_leaf_mode_0_;
@@ -236,6 +261,17 @@ template <> struct range_iterator_leaf_mode_0_<true, true> : std::integral_const
 template <typename R> struct range_iterator_leaf_mode_ : range_iterator_leaf_mode_0_<has_data<R>::value, has_size<R>::value> { };
 template <> struct range_iterator_leaf_mode_<range_index_t> : std::integral_constant<iterator_mode, iterator_mode::range_index> { };
 template <> struct range_iterator_leaf_mode_<tuple_index_t> : std::integral_constant<iterator_mode, iterator_mode::tuple_index> { };
+template <typename F, typename N, typename... Rs> struct range_iterator_leaf_mode_<transform_range<F, N, Rs...>> : std::integral_constant<iterator_mode, iterator_mode::transform> { };
+template <typename IndexR, typename DataR, std::ptrdiff_t PrefetchDistance> struct range_iterator_leaf_mode_<indirect_range<IndexR, DataR, PrefetchDistance>> : std::integral_constant<iterator_mode, iterator_mode::indirect> { };
+template <typename T, typename N, typename S, typename M> struct range_iterator_leaf_mode_<strided_range<T, N, S, M>> : std::integral_constant<iterator_mode, iterator_mode::strided> { };
+
+    // Views passed to `range_zip()` by value are held as const objects, so the const `begin()` of the zipped range can iterate
+    // over them through their const interface.
+template <typename R> struct zip_range_element_ { using type = R; };
+template <typename F, typename N, typename... Rs> struct zip_range_element_<transform_range<F, N, Rs...>> { using type = transform_range<F, N, Rs...> const; };
+template <typename IndexR, typename DataR, std::ptrdiff_t PrefetchDistance> struct zip_range_element_<indirect_range<IndexR, DataR, PrefetchDistance>> { using type = indirect_range<IndexR, DataR, PrefetchDistance> const; };
+template <typename T, typename N, typename S, typename M> struct zip_range_element_<strided_range<T, N, S, M>> { using type = strided_range<T, N, S, M> const; };
+template <typename R> using zip_range_element_t = typename zip_range_element_<R>::type;
 
 template <typename R, typename = void> struct tuple_iterator_leaf_mode_ : range_iterator_leaf_mode_<R> { };
 template <typename R> struct tuple_iterator_leaf_mode_<R, std::void_t<decltype(std::tuple_size<R>::value)>> : std::integral_constant<iterator_mode, iterator_mode::tuple_element> { };
@@ -555,15 +591,38 @@ constexpr auto range_size_0(std::false_type /*isTupleLike*/, R const& range) noe
 {
     return detail::range_size_1(has_size<R>{ }, range);
 }
+    // A tuple-like type which is also a range (such as `soa_span<>`, whose tuple elements are its columns) has a static size
+    // only if the tuple elements are the range elements, as is the case for `std::array<>`.
+template <typename R, typename = void> struct tuple_elements_are_range_elements_ : std::false_type { };
+template <typename R> struct tuple_elements_are_range_elements_<R, std::void_t<typename R::value_type, std::tuple_element_t<0, R>>> : std::is_same<typename R::value_type, std::remove_cv_t<std::tuple_element_t<0, R>>> { };
+template <typename R, bool IsTupleLike = is_tuple_like<R>::value> struct has_static_range_size_ : std::false_type { };
+template <typename R> struct has_static_range_size_<R, true> : std::disjunction<std::negation<has_size<R>>, std::bool_constant<std::tuple_size<R>::value == 0>, tuple_elements_are_range_elements_<R>> { };
+
 template <typename R>
 constexpr auto range_size(R const& range) noexcept
 {
-    return detail::range_size_0(is_tuple_like<R>{ }, range);
+    return detail::range_size_0(has_static_range_size_<R>{ }, range);
 }
 constexpr dim_constant<unknown_size> range_size(range_index_t) noexcept
 {
     return { };
 }
+template <typename F, typename N, typename... Rs>
+constexpr N range_size(transform_range<F, N, Rs...> const& range) noexcept
+{
+        // retain static sizes of the underlying ranges
+    return range._size();
+}
+template <typename IndexR, typename DataR, std::ptrdiff_t PrefetchDistance>
+constexpr auto range_size(indirect_range<IndexR, DataR, PrefetchDistance> const& range) noexcept
+{
+    return detail::range_size(range._indices());
+}
+template <typename T, typename N, typename S, typename M>
+constexpr N range_size(strided_range<T, N, S, M> const& range) noexcept
+{
+    return range._size();
+}
 
 
 } // namespace detail
@@ -3,8 +3,11 @@
 #define INCLUDED_MAKESHIFT_EXPERIMENTAL_ALGORITHM_HPP_
 
 
-#include <utility>   // for swap()
-#include <iterator>  // for iterator_traits<>
+#include <random>       // for seed_seq
+#include <cstddef>      // for size_t, ptrdiff_t
+#include <utility>      // for swap(), forward<>(), tuple_size<>, make_index_sequence<>
+#include <iterator>     // for iterator_traits<>, size()
+#include <type_traits>  // for decay<>, is_same<>, conjunction<>, is_constructible<>
 
 #include <gsl-lite/gsl-lite.hpp>  // for gsl_Expects(), gsl_CPP17_OR_GREATER
 
@@ -13,6 +16,7 @@
 #endif // !gsl_CPP17_OR_GREATER
 
 #include <makeshift/detail/algorithm.hpp>
+#include <makeshift/experimental/detail/algorithm.hpp>
 
 
 namespace makeshift {
@@ -87,6 +91,23 @@ apply_reverse_permutation(RandomIt first, RandomIt last, IndexRandomIt indices)
     }
 }
 
+    //
+    // Permutes the range of elements [first, last) using the permutation given by the index range, which is left unchanged.
+    // Small ranges are permuted in-place by following the cycles of the permutation, using a bitset to mark visited elements.
+    // For large ranges, the elements are gathered into a scratch buffer and moved back. In either case, the indices are checked
+    // to form a permutation.
+    //
+template <typename RandomIt, typename IndexRandomIt>
+void
+apply_permutation_nondestructive(RandomIt first, RandomIt last, IndexRandomIt indices)
+{
+        // We deliberately don't use `std::distance()` in order to support iterators with proxy reference types (which cannot
+        // implement LegacyRandomAccessIterator even though they may be random-access).
+    std::ptrdiff_t length = last - first;
+
+    detail::apply_permutation_nondestructive(first, length, indices);
+}
+
 
     //
     // Given a list of ranges, returns a range of tuples. The range returns a sentinel as end iterator.
@@ -107,6 +128,236 @@ range_zip_sentinel(Rs&&... ranges)
 }
 
 
+    //
+    // Execution policy for parallel overloads of `range_*()` algorithms. Parallel algorithms split the iteration range into
+    // contiguous blocks, each of which is processed on a thread of its own; the calling thread processes the first block and
+    // waits for the other threads to finish.
+    //
+struct parallel_policy
+{
+        // Maximal number of threads to use. If non-positive, `std::thread::hardware_concurrency()` threads are used.
+    gsl::dim numThreads = 0;
+
+        // Minimal number of elements per block. Ranges with fewer than `2*minBlockSize` elements are processed sequentially.
+    gsl::dim minBlockSize = 16384;
+};
+
+
+    //
+    // Parallel version of `range_inclusive_scan()`. The reducer is assumed to be associative, and the output range must be
+    // random-access. The output range may alias one of the input ranges.
+    //ᅟ
+    //ᅟ    range_inclusive_scan(parallel_policy{ }, 0, std::plus<>{ }, std::identity{ }, offsets, counts);
+    //
+template <typename T, typename ReduceFuncT, typename TransformFuncT, typename OutputR, typename... Rs>
+std::decay_t<T>
+range_inclusive_scan(parallel_policy policy, T&& initialValue, ReduceFuncT&& reduce, TransformFuncT&& transform, OutputR&& output, Rs&&... ranges)
+{
+    static_assert(sizeof...(Rs) != 0, "no input range given");
+
+    return detail::parallel_scan<true>(policy.numThreads, policy.minBlockSize, std::decay_t<T>(std::forward<T>(initialValue)), reduce, transform, output, ranges...);
+}
+
+    //
+    // Parallel version of `range_exclusive_scan()`. The reducer is assumed to be associative, and the output range must be
+    // random-access. The output range may alias one of the input ranges.
+    //ᅟ
+    //ᅟ    range_exclusive_scan(parallel_policy{ }, 0, std::plus<>{ }, std::identity{ }, offsets, counts);
+    //
+template <typename T, typename ReduceFuncT, typename TransformFuncT, typename OutputR, typename... Rs>
+std::decay_t<T>
+range_exclusive_scan(parallel_policy policy, T&& initialValue, ReduceFuncT&& reduce, TransformFuncT&& transform, OutputR&& output, Rs&&... ranges)
+{
+    static_assert(sizeof...(Rs) != 0, "no input range given");
+
+    return detail::parallel_scan<false>(policy.numThreads, policy.minBlockSize, std::decay_t<T>(std::forward<T>(initialValue)), reduce, transform, output, ranges...);
+}
+
+
+    //
+    // Parallel version of `range_copy_if()`. The matching elements are counted first to determine the exact output offset of
+    // every block, so the predicate is called twice for every set of input elements and must return the same result both times.
+    // The output range must be random-access.
+    //ᅟ
+    //ᅟ    auto numAlive = range_copy_if(parallel_policy{ },
+    //ᅟ        [](auto&& particle) { return get<2>(particle) > 0; },
+    //ᅟ        aliveParticles, particles);
+    //
+template <typename PredicateT, typename OutputR, typename... Rs>
+std::ptrdiff_t
+range_copy_if(parallel_policy policy, PredicateT&& predicate, OutputR&& output, Rs&&... ranges)
+{
+    static_assert(!std::conjunction_v<std::is_same<std::decay_t<Rs>, detail::range_index_t>...>, "no input range given");
+
+    return detail::parallel_copy_if(policy.numThreads, policy.minBlockSize, predicate, output, ranges...);
+}
+
+
+    //
+    // Parallel version of `shuffle()` which supports iterators with proxy reference types such as `std::vector<bool>` or
+    // `soa_span<>`. Blocks of the range are shuffled in parallel and then merged pairwise with the MergeShuffle algorithm,
+    // which retains uniformity. Every block is shuffled with a generator of the same type as `rng` which is seeded with words
+    // drawn from `rng`. The resulting permutation depends on the number of blocks used.
+    //ᅟ
+    //ᅟ    shuffle(parallel_policy{ }, v.begin(), v.end(), std::mt19937_64{ seed });
+    //
+template <typename RandomIt, typename URBG>
+void
+shuffle(parallel_policy policy, RandomIt first, RandomIt last, URBG&& rng)
+{
+    static_assert(detail::is_full_range_urbg_<URBG>::value, "parallel shuffle requires a random bit generator which produces uniformly distributed 32-bit or 64-bit words");
+    static_assert(std::is_constructible<std::remove_cvref_t<URBG>, std::seed_seq&>::value, "parallel shuffle requires a random bit generator which can be seeded with a std::seed_seq");
+
+    detail::parallel_shuffle(policy.numThreads, policy.minBlockSize, first, std::ptrdiff_t(last - first), rng);
+}
+
+
+    //
+    // Parallel version of `range_iota()`. The range must be random-access. Every block starts with `value + first`, where
+    // `first` is the index of the first element of the block, and is then filled by repetitively evaluating `++value`. Every
+    // block is initialised by the thread which processes it, which places the pages of a freshly allocated range on the memory
+    // nodes of the initialising threads if the operating system uses a first-touch page placement policy.
+    //ᅟ
+    //ᅟ    auto indices = std::vector<gsl::index>(n);
+    //ᅟ    range_iota(parallel_policy{ }, indices, gsl::index(0));
+    //
+template <typename R, typename T>
+void
+range_iota(parallel_policy policy, R&& range, T value)
+{
+    detail::parallel_store_sequence(policy.numThreads, policy.minBlockSize, range,
+        [&value](gsl::index first)
+        {
+            return [blockValue = T(value + first)]() mutable -> T { return blockValue++; };
+        });
+}
+
+    //
+    // Parallel version of `range_fill()`. The range must be random-access. Every block is initialised by the thread which
+    // processes it, which places the pages of a freshly allocated range on the memory nodes of the initialising threads if the
+    // operating system uses a first-touch page placement policy.
+    //ᅟ
+    //ᅟ    auto field = std::vector<double>(n);
+    //ᅟ    range_fill(parallel_policy{ }, field, 0.);
+    //
+template <typename R, typename T>
+void
+range_fill(parallel_policy policy, R&& range, T const& value)
+{
+    detail::parallel_store_sequence(policy.numThreads, policy.minBlockSize, range,
+        [&value](gsl::index)
+        {
+            return [&value]() -> T const& { return value; };
+        });
+}
+
+    //
+    // Parallel version of `range_generate()`. The range must be random-access, and the functor is called concurrently from
+    // different threads. Every block is initialised by the thread which processes it, which places the pages of a freshly
+    // allocated range on the memory nodes of the initialising threads if the operating system uses a first-touch page placement
+    // policy.
+    //ᅟ
+    //ᅟ    range_generate(parallel_policy{ }, weights, [] { return 1.; });
+    //
+template <typename R, typename F>
+void
+range_generate(parallel_policy policy, R&& range, F const& generate)
+{
+    detail::parallel_store_sequence(policy.numThreads, policy.minBlockSize, range,
+        [&generate](gsl::index)
+        {
+            return [&generate]() -> decltype(auto) { return generate(); };
+        });
+}
+
+
+    //
+    // Parallel version of `range_find_if()`. Returns the index of the first set of range elements for which the predicate is
+    // satisfied, or -1 if there is no such set. Workers which can no longer find a lower matching index stop early.
+    //ᅟ
+    //ᅟ    gsl::index firstInvalid = range_find_if(parallel_policy{ },
+    //ᅟ        [](double x, double y) { return !std::isfinite(x) || !std::isfinite(y); },
+    //ᅟ        xs, ys);
+    //
+template <typename PredicateT, typename... Rs>
+[[nodiscard]] gsl::index
+range_find_if(parallel_policy policy, PredicateT&& predicate, Rs&&... ranges)
+{
+    static_assert(!std::conjunction_v<std::is_same<std::decay_t<Rs>, detail::range_index_t>...>, "no range argument given");
+
+    return detail::parallel_find_if<true>(policy.numThreads, policy.minBlockSize, predicate, ranges...);
+}
+
+    //
+    // Parallel version of `range_any_of()`. All workers stop as soon as a set of range elements satisfying the predicate has
+    // been found.
+    //ᅟ
+    //ᅟ    bool anyInvalid = range_any_of(parallel_policy{ },
+    //ᅟ        [](double x, double y) { return !std::isfinite(x) || !std::isfinite(y); },
+    //ᅟ        xs, ys);
+    //
+template <typename PredicateT, typename... Rs>
+[[nodiscard]] bool
+range_any_of(parallel_policy policy, PredicateT&& predicate, Rs&&... ranges)
+{
+    static_assert(!std::conjunction_v<std::is_same<std::decay_t<Rs>, detail::range_index_t>...>, "no range argument given");
+
+    return detail::parallel_find_if<false>(policy.numThreads, policy.minBlockSize, predicate, ranges...) != -1;
+}
+
+    //
+    // Parallel version of `range_all_of()`. All workers stop as soon as a set of range elements violating the predicate has
+    // been found.
+    //ᅟ
+    //ᅟ    bool allValid = range_all_of(parallel_policy{ },
+    //ᅟ        [](double x, double y) { return std::isfinite(x) && std::isfinite(y); },
+    //ᅟ        xs, ys);
+    //
+template <typename PredicateT, typename... Rs>
+[[nodiscard]] bool
+range_all_of(parallel_policy policy, PredicateT&& predicate, Rs&&... ranges)
+{
+    static_assert(!std::conjunction_v<std::is_same<std::decay_t<Rs>, detail::range_index_t>...>, "no range argument given");
+
+    auto negatedPredicate = [&predicate](auto&&... args) -> bool { return !predicate(std::forward<decltype(args)>(args)...); };
+    return detail::parallel_find_if<false>(policy.numThreads, policy.minBlockSize, negatedPredicate, ranges...) == -1;
+}
+
+    //
+    // Parallel version of `range_none_of()`. All workers stop as soon as a set of range elements satisfying the predicate has
+    // been found.
+    //ᅟ
+    //ᅟ    bool noneInvalid = range_none_of(parallel_policy{ },
+    //ᅟ        [](double x, double y) { return !std::isfinite(x) || !std::isfinite(y); },
+    //ᅟ        xs, ys);
+    //
+template <typename PredicateT, typename... Rs>
+[[nodiscard]] bool
+range_none_of(parallel_policy policy, PredicateT&& predicate, Rs&&... ranges)
+{
+    static_assert(!std::conjunction_v<std::is_same<std::decay_t<Rs>, detail::range_index_t>...>, "no range argument given");
+
+    return detail::parallel_find_if<false>(policy.numThreads, policy.minBlockSize, predicate, ranges...) == -1;
+}
+
+
+    //
+    // Parallel version of `apply_permutation_nondestructive()` for tuple-like collections of columns such as `soa_span<>`. The
+    // columns are permuted independently and in parallel, all using the same index range.
+    //ᅟ
+    //ᅟ    auto particles = soa_span(gsl::span(xs), gsl::span(ys), gsl::span(zs));
+    //ᅟ    apply_permutation_nondestructive(parallel_policy{ }, particles, sortedIndices.begin());
+    //
+template <typename ColumnsT, typename IndexRandomIt>
+void
+apply_permutation_nondestructive(parallel_policy policy, ColumnsT const& columns, IndexRandomIt indices)
+{
+    constexpr std::size_t numColumns = std::tuple_size<ColumnsT>::value;
+
+    detail::parallel_apply_permutation_to_columns(policy.numThreads, policy.minBlockSize, gsl::dim(std::size(columns)), columns, indices, std::make_index_sequence<numColumns>{ });
+}
+
+
 } // namespace makeshift
 
 
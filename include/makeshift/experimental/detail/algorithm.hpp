@@ -0,0 +1,613 @@
+#ifndef INCLUDED_MAKESHIFT_EXPERIMENTAL_DETAIL_ALGORITHM_HPP_
+#define INCLUDED_MAKESHIFT_EXPERIMENTAL_DETAIL_ALGORITHM_HPP_
+
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>    // for min(), max(), fill()
+#include <random>       // for seed_seq
+#include <cstddef>      // for size_t, ptrdiff_t
+#include <cstdint>      // for uint32_t, uint64_t
+#include <iterator>     // for begin(), end(), iterator_traits<>, random_access_iterator_tag
+#include <utility>      // for move(), forward<>(), swap(), index_sequence<>
+#include <optional>
+#include <exception>    // for exception_ptr, current_exception(), rethrow_exception()
+#include <type_traits>  // for decay<>, is_same<>, is_base_of<>, is_default_constructible<>, is_move_assignable<>
+
+#include <gsl-lite/gsl-lite.hpp>  // for dim, index, gsl_Expects(), gsl_Assert()
+
+#include <makeshift/detail/macros.hpp>     // for MAKESHIFT_DETAIL_FORCEINLINE
+#include <makeshift/detail/algorithm.hpp>  // for make_zip_begin_iterator(), shuffle_batched(), bounded_random(), store_nontemporal()
+
+#include <makeshift/experimental/buffer.hpp>  // for make_buffer<>()
+
+
+namespace makeshift {
+
+
+namespace gsl = ::gsl_lite;
+
+
+namespace detail {
+
+
+struct block_bounds
+{
+    gsl::index first;
+    gsl::index last;
+};
+
+    // Splits the index range [0, n) into `numBlocks` contiguous blocks whose sizes differ by at most 1.
+constexpr block_bounds
+get_block_bounds(gsl::dim n, gsl::dim numBlocks, gsl::index block) noexcept
+{
+    return {
+        n / numBlocks * block + std::min(block, n % numBlocks),
+        n / numBlocks * (block + 1) + std::min(block + 1, n % numBlocks)
+    };
+}
+
+    // Blocked kernels advance to the beginning of every block and therefore need random-access ranges with a known number of
+    // elements.
+template <typename N, typename... Rs>
+constexpr void
+check_blocked_ranges(void)
+{
+    static_assert(std::is_base_of<std::random_access_iterator_tag, common_iterator_tag<range_iterator_concept_t<std::decay_t<Rs>>...>>::value,
+        "parallel algorithms require random-access ranges");
+    static_assert(!std::is_same<N, dim_constant<unknown_size>>::value, "cannot infer the number of elements");
+}
+
+inline gsl::dim
+get_num_blocks(gsl::dim numThreads, gsl::dim minBlockSize, gsl::dim n) noexcept
+{
+    if (numThreads <= 0)
+    {
+        numThreads = std::max(gsl::dim(std::thread::hardware_concurrency()), gsl::dim(1));
+    }
+    gsl::dim maxNumBlocks = std::max(n / std::max(minBlockSize, gsl::dim(1)), gsl::dim(1));
+    return std::min(numThreads, maxNumBlocks);
+}
+
+    // Calls `func(block)` for every block in [0, numBlocks) and waits for all calls to complete. Block 0 is processed on the
+    // calling thread, every other block on a thread of its own. If one or more calls throw an exception, the exception thrown
+    // for the lowest block index is rethrown after all threads have been joined.
+template <typename F>
+void
+parallel_for_blocks(gsl::dim numBlocks, F&& func)
+{
+    gsl_Expects(numBlocks >= 1);
+
+    if (numBlocks == 1)
+    {
+        func(gsl::index(0));
+        return;
+    }
+
+    auto exceptions = std::vector<std::exception_ptr>(numBlocks);
+    auto threads = std::vector<std::thread>{ };
+    threads.reserve(numBlocks - 1);
+    auto runBlock = [&func, &exceptions](gsl::index block) noexcept
+    {
+        try
+        {
+            func(block);
+        }
+        catch (...)
+        {
+            exceptions[block] = std::current_exception();
+        }
+    };
+    try
+    {
+        for (gsl::index block = 1; block < numBlocks; ++block)
+        {
+            threads.emplace_back(runBlock, block);
+        }
+    }
+    catch (...)
+    {
+            // Thread creation failed; wait for the threads already running before propagating the error.
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        throw;
+    }
+    runBlock(0);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (auto& exception : exceptions)
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+template <bool Inclusive, typename T, typename ReduceFuncT, typename TransformFuncT, typename N, typename OutputR, typename... Rs>
+MAKESHIFT_DETAIL_FORCEINLINE void
+scan_block(T& result, ReduceFuncT& reduce, TransformFuncT& transform, N mergedSize, block_bounds bounds, OutputR& output, Rs&... ranges)
+{
+    auto it = detail::make_zip_begin_iterator(mergedSize, output, ranges...);
+    it += bounds.first;
+    for (gsl::index i = bounds.first; i != bounds.last; ++i, ++it)
+    {
+        it.apply(
+            [&](auto&& dst, auto&&... elems)
+            {
+                auto value = transform(std::forward<decltype(elems)>(elems)...);
+                if constexpr (Inclusive)
+                {
+                    result = reduce(std::move(result), std::move(value));
+                    dst = result;
+                }
+                else
+                {
+                    dst = result;
+                    result = reduce(std::move(result), std::move(value));
+                }
+            });
+    }
+}
+
+template <typename T, typename ReduceFuncT, typename TransformFuncT, typename N, typename... Rs>
+T
+reduce_block(ReduceFuncT& reduce, TransformFuncT& transform, N mergedSize, block_bounds bounds, Rs&... ranges)
+{
+    gsl_Expects(bounds.first != bounds.last);
+
+    auto it = detail::make_zip_begin_iterator(mergedSize, ranges...);
+    it += bounds.first;
+    T result = it.apply(transform);
+    ++it;
+    for (gsl::index i = bounds.first + 1; i != bounds.last; ++i, ++it)
+    {
+        result = reduce(std::move(result), it.apply(transform));
+    }
+    return result;
+}
+
+    // Two-pass parallel scan: every block except the last one is reduced in parallel, the block reductions are then scanned
+    // sequentially, and finally every block is scanned in parallel starting with the reduction of its predecessors.
+template <bool Inclusive, typename T, typename ReduceFuncT, typename TransformFuncT, typename OutputR, typename... Rs>
+T
+parallel_scan(gsl::dim numThreads, gsl::dim minBlockSize, T initialValue, ReduceFuncT& reduce, TransformFuncT& transform, OutputR& output, Rs&... ranges)
+{
+    auto mergedSize = detail::merge_sizes(detail::range_size(output), detail::range_size(ranges)...);
+    detail::check_blocked_ranges<decltype(mergedSize), OutputR, Rs...>();
+    gsl::dim n = mergedSize;
+    gsl::dim numBlocks = detail::get_num_blocks(numThreads, minBlockSize, n);
+    if (numBlocks == 1)
+    {
+        detail::scan_block<Inclusive>(initialValue, reduce, transform, mergedSize, block_bounds{ 0, n }, output, ranges...);
+        return initialValue;
+    }
+
+        // Pass 1: reduce blocks.
+    auto blockResults = std::vector<std::optional<T>>(numBlocks - 1);
+    detail::parallel_for_blocks(numBlocks - 1,
+        [&](gsl::index block)
+        {
+            blockResults[block].emplace(detail::reduce_block<T>(reduce, transform, mergedSize, detail::get_block_bounds(n, numBlocks, block), ranges...));
+        });
+
+        // Scan block reductions.
+    auto blockInitialValues = std::vector<T>{ };
+    blockInitialValues.reserve(numBlocks);
+    blockInitialValues.push_back(std::move(initialValue));
+    for (gsl::index block = 0; block != numBlocks - 1; ++block)
+    {
+        blockInitialValues.push_back(reduce(T(blockInitialValues.back()), std::move(*blockResults[block])));
+    }
+
+        // Pass 2: scan blocks.
+    detail::parallel_for_blocks(numBlocks,
+        [&](gsl::index block)
+        {
+            detail::scan_block<Inclusive>(blockInitialValues[block], reduce, transform, mergedSize, detail::get_block_bounds(n, numBlocks, block), output, ranges...);
+        });
+    return std::move(blockInitialValues.back());
+}
+
+
+template <typename PredicateT, typename InputIt>
+gsl::dim
+count_if_block(PredicateT& predicate, InputIt it, gsl::index first, gsl::index last)
+{
+    gsl::dim count = 0;
+    for (gsl::index i = first; i != last; ++i, ++it)
+    {
+        count += gsl::dim(bool(it.apply(predicate)));
+    }
+    return count;
+}
+
+    // Parallel stream compaction: the matching elements in every block are counted in parallel, the counts are scanned
+    // sequentially to obtain the output offset of every block, and finally every block is compacted in parallel.
+template <typename PredicateT, typename OutputR, typename... Rs>
+std::ptrdiff_t
+parallel_copy_if(gsl::dim numThreads, gsl::dim minBlockSize, PredicateT& predicate, OutputR& output, Rs&... ranges)
+{
+    constexpr bool branchless = ranges_permit_branchless_compaction_<OutputR>::value;
+
+    auto outputSize = detail::range_size(output);
+    auto mergedSize = detail::merge_sizes(detail::range_size(ranges)...);
+    detail::check_blocked_ranges<decltype(mergedSize), OutputR, Rs...>();
+    gsl::dim n = mergedSize;
+    gsl::dim numBlocks = detail::get_num_blocks(numThreads, minBlockSize, n);
+
+        // Pass 1: count matching elements.
+    auto counts = std::vector<gsl::dim>(numBlocks);
+    detail::parallel_for_blocks(numBlocks,
+        [&](gsl::index block)
+        {
+            auto bounds = detail::get_block_bounds(n, numBlocks, block);
+            auto it = detail::make_zip_begin_iterator(mergedSize, ranges...);
+            it += bounds.first;
+            counts[block] = detail::count_if_block(predicate, it, bounds.first, bounds.last);
+        });
+
+        // Scan counts to obtain block offsets.
+    auto offsets = std::vector<gsl::index>(numBlocks);
+    gsl::dim total = 0;
+    for (gsl::index block = 0; block != numBlocks; ++block)
+    {
+        offsets[block] = total;
+        total += counts[block];
+    }
+    gsl_Expects(total <= gsl::dim(outputSize));
+
+        // Pass 2: copy matching elements. Because the exact number of elements is known for every block, the branchless
+        // kernel never writes past the output segment of the block.
+    detail::parallel_for_blocks(numBlocks,
+        [&](gsl::index block)
+        {
+            auto bounds = detail::get_block_bounds(n, numBlocks, block);
+            auto out = detail::make_zip_begin_iterator(outputSize, output);
+            out += offsets[block];
+            auto it = detail::make_zip_begin_iterator(mergedSize, ranges...);
+            it += bounds.first;
+            auto end = it + (bounds.last - bounds.first);
+            gsl::dim count = detail::copy_if_block<branchless>(predicate, out, counts[block], it, end);
+            gsl_Assert(count == counts[block]);  // predicate must return the same result when called twice for the same elements
+        });
+    return total;
+}
+
+
+    // Merges two uniformly shuffled adjacent subranges [start, mid) and [mid, end) into a uniformly shuffled range (A. Bacher,
+    // O. Bodini, A. Hollender, J. Lumbroso, "MergeShuffle: A Very Fast, Parallel Random Permutation Algorithm", 2015).
+template <typename RandomIt, typename URBG>
+void
+merge_shuffled(RandomIt first, std::ptrdiff_t start, std::ptrdiff_t mid, std::ptrdiff_t end, URBG& rng)
+{
+    using std::swap;
+
+    std::ptrdiff_t i = start;
+    std::ptrdiff_t j = mid;
+    std::uint64_t bits = 0;
+    int numBits = 0;
+    for (;;)
+    {
+        if (numBits == 0)
+        {
+            bits = detail::random_word_64(rng);
+            numBits = 64;
+        }
+        bool bit = (bits & 1) != 0;
+        bits >>= 1;
+        --numBits;
+        if (bit)
+        {
+            if (j == end) break;
+            swap(first[i], first[j]);
+            ++j;
+        }
+        else
+        {
+            if (i == j) break;
+        }
+        ++i;
+    }
+
+        // Insert the remaining elements at uniformly chosen positions.
+    for (; i != end; ++i)
+    {
+        std::ptrdiff_t m = start + std::ptrdiff_t(detail::bounded_random(rng, std::uint64_t(i - start + 1)));
+        swap(first[i], first[m]);
+    }
+}
+
+    // Parallel MergeShuffle: every block is shuffled in parallel with a generator of its own, and adjacent blocks are then merged
+    // pairwise in parallel until a single block remains. The generators are seeded sequentially from the given generator, so
+    // the permutation is reproducible for a given seed and a given number of blocks.
+template <typename RandomIt, typename URBG>
+void
+parallel_shuffle(gsl::dim numThreads, gsl::dim minBlockSize, RandomIt first, std::ptrdiff_t length, URBG& rng)
+{
+    gsl::dim numBlocks = detail::get_num_blocks(numThreads, minBlockSize, length);
+    if (numBlocks == 1)
+    {
+        detail::shuffle_batched(first, length, rng);
+        return;
+    }
+
+    using Generator = std::remove_cv_t<URBG>;
+    auto generators = std::vector<Generator>{ };
+    generators.reserve(numBlocks);
+    for (gsl::index block = 0; block != numBlocks; ++block)
+    {
+        std::uint32_t seeds[8];
+        for (gsl::index k = 0; k != 8; k += 2)
+        {
+            std::uint64_t word = detail::random_word_64(rng);
+            seeds[k] = std::uint32_t(word);
+            seeds[k + 1] = std::uint32_t(word >> 32);
+        }
+        auto seedSeq = std::seed_seq(std::begin(seeds), std::end(seeds));
+        generators.emplace_back(seedSeq);
+    }
+
+    auto bounds = std::vector<std::ptrdiff_t>(numBlocks + 1);
+    for (gsl::index block = 0; block != numBlocks; ++block)
+    {
+        bounds[block] = detail::get_block_bounds(length, numBlocks, block).first;
+    }
+    bounds[numBlocks] = length;
+
+    detail::parallel_for_blocks(numBlocks,
+        [&](gsl::index block)
+        {
+            detail::shuffle_batched(first + bounds[block], bounds[block + 1] - bounds[block], generators[block]);
+        });
+
+    while (bounds.size() > 2)
+    {
+        gsl::dim numSegments = gsl::dim(bounds.size()) - 1;
+        detail::parallel_for_blocks(numSegments / 2,
+            [&](gsl::index pair)
+            {
+                detail::merge_shuffled(first, bounds[2*pair], bounds[2*pair + 1], bounds[2*pair + 2], generators[pair]);
+            });
+
+            // Drop the boundaries between merged segments.
+        gsl::index k = 0;
+        for (gsl::index segment = 0; segment < numSegments; segment += 2)
+        {
+            bounds[k++] = bounds[segment];
+        }
+        bounds[k++] = bounds[numSegments];
+        bounds.resize(k);
+    }
+}
+
+
+    // Permutations over ranges larger than this are applied by gathering the elements into a scratch buffer rather than by
+    // following cycles in-place; for large ranges, cycle-following suffers from a chain of dependent random memory accesses.
+constexpr std::size_t permutation_gather_threshold_bytes = std::size_t(1) << 18;
+
+    // Bitset of the elements visited while applying a permutation, used to check that the indices form a permutation.
+constexpr std::ptrdiff_t visited_word_bits = 64;
+constexpr std::size_t
+visited_bitset_size(std::ptrdiff_t length)
+{
+    return std::size_t((length + visited_word_bits - 1)/visited_word_bits);
+}
+template <typename BufferT>
+MAKESHIFT_DETAIL_FORCEINLINE bool
+is_visited(BufferT const& visited, std::ptrdiff_t i)
+{
+    return (visited[i/visited_word_bits] & (std::uint64_t(1) << (i % visited_word_bits))) != 0;
+}
+template <typename BufferT>
+MAKESHIFT_DETAIL_FORCEINLINE void
+mark_visited(BufferT& visited, std::ptrdiff_t i)
+{
+    visited[i/visited_word_bits] |= std::uint64_t(1) << (i % visited_word_bits);
+}
+
+template <typename RandomIt, typename IndexRandomIt>
+void
+apply_permutation_by_cycles(RandomIt first, std::ptrdiff_t length, IndexRandomIt indices)
+{
+    using std::swap;
+
+    auto visited = makeshift::make_buffer<std::uint64_t, 16>(detail::visited_bitset_size(length));
+    std::fill(visited.begin(), visited.end(), std::uint64_t(0));
+    for (std::ptrdiff_t i = 0; i != length; ++i)
+    {
+        if (detail::is_visited(visited, i)) continue;
+
+        detail::mark_visited(visited, i);
+        std::ptrdiff_t current = i;
+        std::ptrdiff_t next = std::ptrdiff_t(indices[current]);
+        while (next != i)
+        {
+            gsl_Expects(next >= 0 && next < length); // make sure index is valid
+            gsl_Expects(!detail::is_visited(visited, next)); // make sure this is actually a permutation, which isn't the case if an index occurs more than once
+            swap(first[current], first[next]);
+            detail::mark_visited(visited, next);
+            current = next;
+            next = std::ptrdiff_t(indices[current]);
+        }
+    }
+}
+
+template <typename RandomIt, typename IndexRandomIt>
+void
+apply_permutation_by_gather(RandomIt first, std::ptrdiff_t length, IndexRandomIt indices)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+
+    auto visited = makeshift::make_buffer<std::uint64_t, 16>(detail::visited_bitset_size(length));
+    std::fill(visited.begin(), visited.end(), std::uint64_t(0));
+    auto scratch = makeshift::make_buffer<T>(std::size_t(length));
+    for (std::ptrdiff_t i = 0; i != length; ++i)
+    {
+        std::ptrdiff_t index = std::ptrdiff_t(indices[i]);
+        gsl_Expects(index >= 0 && index < length); // make sure index is valid
+        gsl_Expects(!detail::is_visited(visited, index)); // make sure this is actually a permutation, which isn't the case if an index occurs more than once
+        detail::mark_visited(visited, index);
+        scratch[i] = std::move(first[index]);
+    }
+    for (std::ptrdiff_t i = 0; i != length; ++i)
+    {
+        first[i] = std::move(scratch[i]);
+    }
+}
+
+template <typename RandomIt, typename IndexRandomIt>
+void
+apply_permutation_nondestructive(RandomIt first, std::ptrdiff_t length, IndexRandomIt indices)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+
+    if constexpr (std::is_default_constructible<T>::value && std::is_move_assignable<T>::value)
+    {
+        if (std::size_t(length)*sizeof(T) > permutation_gather_threshold_bytes)
+        {
+            detail::apply_permutation_by_gather(first, length, indices);
+            return;
+        }
+    }
+    detail::apply_permutation_by_cycles(first, length, indices);
+}
+
+template <std::size_t I, typename ColumnsT, typename IndexRandomIt>
+void
+apply_permutation_to_column(ColumnsT const& columns, IndexRandomIt indices)
+{
+    using std::get;
+    using std::begin;
+    using std::end;
+
+    auto&& column = get<I>(columns);
+    auto first = begin(column);
+    detail::apply_permutation_nondestructive(first, std::ptrdiff_t(end(column) - first), indices);
+}
+
+template <typename ColumnsT, typename IndexRandomIt, std::size_t... Is>
+void
+parallel_apply_permutation_to_columns(gsl::dim numThreads, gsl::dim minBlockSize, gsl::dim length, ColumnsT const& columns, IndexRandomIt indices, std::index_sequence<Is...>)
+{
+    using ApplyFunc = void (*)(ColumnsT const&, IndexRandomIt);
+    constexpr ApplyFunc applyFuncs[] = { &detail::apply_permutation_to_column<Is, ColumnsT, IndexRandomIt>... };
+    constexpr gsl::dim numColumns = sizeof...(Is);
+
+    gsl::dim numBlocks = length >= 2*minBlockSize
+        ? detail::get_num_blocks(numThreads, 1, numColumns)
+        : 1;
+    detail::parallel_for_blocks(numBlocks,
+        [&](gsl::index block)
+        {
+            auto bounds = detail::get_block_bounds(numColumns, numBlocks, block);
+            for (gsl::index column = bounds.first; column != bounds.last; ++column)
+            {
+                applyFuncs[column](columns, indices);
+            }
+        });
+}
+
+
+    // Parallel first-touch initialisation: every block is initialised by the thread which processes it, so with a first-touch
+    // page placement policy, the pages of a freshly allocated range end up on the memory nodes of the initialising threads.
+    // `makeNext(first)` returns a functor which generates the values for the block starting at index `first`.
+template <typename R, typename MakeNextFuncT>
+void
+parallel_store_sequence(gsl::dim numThreads, gsl::dim minBlockSize, R& range, MakeNextFuncT const& makeNext)
+{
+    auto size = detail::range_size(range);
+    detail::check_blocked_ranges<decltype(size), R>();
+    gsl::dim n = size;
+    gsl::dim numBlocks = detail::get_num_blocks(numThreads, minBlockSize, n);
+
+    bool nonTemporal = false;
+    if constexpr (is_contiguous_arithmetic_range_<R>::value)
+    {
+        using T = typename contiguous_range_element_<R>::type;
+        nonTemporal = std::size_t(n)*sizeof(T) >= nontemporal_store_threshold_bytes;
+    }
+
+    detail::parallel_for_blocks(numBlocks,
+        [&](gsl::index block)
+        {
+            auto bounds = detail::get_block_bounds(n, numBlocks, block);
+            auto next = makeNext(bounds.first);
+            if constexpr (is_contiguous_arithmetic_range_<R>::value)
+            {
+                if (nonTemporal)
+                {
+                    detail::store_nontemporal(std::data(range) + bounds.first, bounds.last - bounds.first, next);
+                    return;
+                }
+            }
+            auto it = detail::make_zip_begin_iterator(size, range);
+            it += bounds.first;
+            for (gsl::index i = bounds.first; i != bounds.last; ++i, ++it)
+            {
+                it.apply([&next](auto&& elem) { elem = next(); });
+            }
+        });
+}
+
+
+    // Number of elements processed by a worker of a cancellable parallel search between two polls of the shared result.
+constexpr gsl::dim cancellation_chunk_size = 1024;
+
+    // Cancellable parallel search. Every block is processed in chunks; between chunks, the worker polls the shared result
+    // and gives up if a match has been found which renders the rest of its block irrelevant. If `Lowest` is true, the lowest
+    // matching index is returned, so a worker only gives up if a match has been found at a lower index than its current
+    // position; otherwise, an arbitrary matching index is returned, and all workers give up as soon as any match is found.
+    // Returns -1 if no match is found.
+template <bool Lowest, typename PredicateT, typename... Rs>
+gsl::index
+parallel_find_if(gsl::dim numThreads, gsl::dim minBlockSize, PredicateT& predicate, Rs&... ranges)
+{
+    auto mergedSize = detail::merge_sizes(detail::range_size(ranges)...);
+    detail::check_blocked_ranges<decltype(mergedSize), Rs...>();
+    gsl::dim n = mergedSize;
+    gsl::dim numBlocks = detail::get_num_blocks(numThreads, minBlockSize, n);
+
+    auto result = std::atomic<gsl::index>(n);
+    detail::parallel_for_blocks(numBlocks,
+        [&](gsl::index block)
+        {
+            auto bounds = detail::get_block_bounds(n, numBlocks, block);
+            auto it = detail::make_zip_begin_iterator(mergedSize, ranges...);
+            it += bounds.first;
+            for (gsl::index chunkFirst = bounds.first; chunkFirst != bounds.last; )
+            {
+                gsl::index current = result.load(std::memory_order_relaxed);
+                if (Lowest ? current < chunkFirst : current != n) return;
+
+                gsl::index chunkLast = std::min(chunkFirst + cancellation_chunk_size, bounds.last);
+                for (gsl::index i = chunkFirst; i != chunkLast; ++i, ++it)
+                {
+                    if (it.apply(predicate))
+                    {
+                            // Atomically lower the shared result to `i`.
+                        while (i < current && !result.compare_exchange_weak(current, i, std::memory_order_relaxed))
+                        {
+                        }
+                        return;
+                    }
+                }
+                chunkFirst = chunkLast;
+            }
+        });
+    gsl::index index = result.load(std::memory_order_relaxed);
+    return index != n ? index : -1;
+}
+
+
+} // namespace detail
+
+} // namespace makeshift
+
+
+#endif // INCLUDED_MAKESHIFT_EXPERIMENTAL_DETAIL_ALGORITHM_HPP_
@@ -3,8 +3,14 @@
 #define INCLUDED_MAKESHIFT_EXPERIMENTAL_DETAIL_VARIANT_HPP_
 
 
-#include <utility>    // for forward<>()
-#include <exception>  // for terminate()
+#include <cstddef>      // for size_t
+#include <utility>      // for forward<>()
+#include <variant>
+#include <exception>    // for terminate()
+#include <type_traits>  // for invoke_result<>, remove_cvref<>, is_same<>
+
+#include <makeshift/detail/variant.hpp>      // for type_seq_<>, flatten_variant_<>, is_not_void<>
+#include <makeshift/detail/type_traits.hpp>  // for instantiate_<>, unique_sequence_<>, filter_sequence_<>
 
 
 namespace makeshift {
@@ -44,6 +50,32 @@ struct variant_cat_<VariantT, VariantT<V0Ts...>, VariantT<V1Ts...>, Vs...>
 {
 };
 
+    // Computes the type of `variant_collection<>` which holds the distinct non-void results of applying the functor to the
+    // elements of a collection with the given element types. If `Flatten` is true, results are variants whose alternatives
+    // are merged.
+template <template <typename...> class CollectionT, bool Flatten, typename F, typename... Ts>
+struct variant_collection_transform_result_
+{
+    using result_seq_ = type_seq_<std::remove_cvref_t<std::invoke_result_t<F&, Ts const&>>...>;
+    using non_void_result_seq_ = typename filter_sequence_<is_not_void, result_seq_>::type;
+    using flat_result_seq_ = typename std::conditional_t<Flatten,
+        flatten_variant_<std::variant, non_void_result_seq_>,
+        std::type_identity<non_void_result_seq_>>::type;
+    using unique_result_seq_ = typename unique_sequence_<flat_result_seq_>::type;
+    using type = typename instantiate_<CollectionT, unique_result_seq_>::type;
+};
+
+    // Counts the elements of the collection for which the functor returns `R`; several element types may map to the same result
+    // type.
+template <typename R, typename F, template <typename...> class CollectionT, typename... Ts>
+std::size_t
+count_transform_results(CollectionT<Ts...> const& collection)
+{
+    return (std::size_t(0) + ... + (std::is_same_v<std::remove_cvref_t<std::invoke_result_t<F&, Ts const&>>, R>
+        ? collection.template segment<Ts>().size()
+        : std::size_t(0)));
+}
+
 
 } // namespace detail
 
@@ -3,10 +3,14 @@
 #define INCLUDED_MAKESHIFT_EXPERIMENTAL_VARIANT_HPP_
 
 
-#include <utility>      // for forward<>()
+#include <span>
+#include <tuple>
+#include <vector>
+#include <cstddef>      // for size_t
+#include <utility>      // for forward<>(), move()
 #include <variant>
 #include <optional>
-#include <type_traits>  // for remove_cv<>, remove_reference<>
+#include <type_traits>  // for remove_cv<>, remove_reference<>, remove_cvref<>, invoke_result<>
 
 #include <gsl-lite/gsl-lite.hpp>  // for gsl_CPP17_OR_GREATER
 
@@ -104,6 +108,218 @@ optional_to_variant(VO&& optionalVariant)
     //
 template <typename... Vs> using variant_cat_t = typename detail::variant_cat_<std::variant, Vs...>::type;
 
+    //
+    // A polymorphic collection which stores the elements of every alternative type in a separate contiguous segment. Unlike
+    // `std::vector<std::variant<Ts...>>`, elements are not padded to the size of the largest alternative, and iterating over
+    // the collection with `for_each()` runs one tight loop per alternative type rather than dispatching on every element.
+    // The relative order of elements is retained only within each segment.
+    //ᅟ
+    //ᅟ    auto shapes = variant_collection<Circle, Rectangle>{ };
+    //ᅟ    shapes.push_back(Circle{ 1. });
+    //ᅟ    shapes.push_back(Rectangle{ 2., 3. });
+    //ᅟ    double totalArea = 0.;
+    //ᅟ    shapes.for_each(overload{
+    //ᅟ        [&](Circle const& c) { totalArea += pi*c.r*c.r; },
+    //ᅟ        [&](Rectangle const& r) { totalArea += r.w*r.h; }
+    //ᅟ    });
+    //
+template <typename... Ts>
+class variant_collection
+{
+    static_assert(std::is_same_v<detail::type_seq_<Ts...>, typename detail::unique_sequence_<detail::type_seq_<Ts...>>::type>,
+        "alternative types must be unique");
+
+private:
+    std::tuple<std::vector<Ts>...> segments_;
+
+    template <typename T> static constexpr bool is_alternative = (std::is_same_v<T, Ts> || ...);
+
+public:
+    using variant_type = std::variant<Ts...>;
+
+    variant_collection(void) = default;
+
+        //
+        // Returns the segment of elements of type `T`.
+        //
+    template <typename T>
+    [[nodiscard]] std::span<T>
+    segment(void) noexcept
+    {
+        static_assert(is_alternative<T>, "T must be one of the alternative types");
+        return std::get<std::vector<T>>(segments_);
+    }
+    template <typename T>
+    [[nodiscard]] std::span<T const>
+    segment(void) const noexcept
+    {
+        static_assert(is_alternative<T>, "T must be one of the alternative types");
+        return std::get<std::vector<T>>(segments_);
+    }
+
+        //
+        // The total number of elements.
+        //
+    [[nodiscard]] std::size_t
+    size(void) const noexcept
+    {
+        return (std::get<std::vector<Ts>>(segments_).size() + ... + std::size_t(0));
+    }
+    [[nodiscard]] bool
+    empty(void) const noexcept
+    {
+        return (std::get<std::vector<Ts>>(segments_).empty() && ...);
+    }
+
+    void
+    clear(void) noexcept
+    {
+        (std::get<std::vector<Ts>>(segments_).clear(), ...);
+    }
+
+        //
+        // Reserves storage for the given number of elements of type `T`.
+        //
+    template <typename T>
+    void
+    reserve(std::size_t count)
+    {
+        static_assert(is_alternative<T>, "T must be one of the alternative types");
+        std::get<std::vector<T>>(segments_).reserve(count);
+    }
+
+    template <typename T, typename... ArgsT>
+    T&
+    emplace_back(ArgsT&&... args)
+    {
+        static_assert(is_alternative<T>, "T must be one of the alternative types");
+        return std::get<std::vector<T>>(segments_).emplace_back(std::forward<ArgsT>(args)...);
+    }
+
+        //
+        // Appends the given element to the segment of its type.
+        //
+    template <typename T>
+    requires (is_alternative<std::remove_cvref_t<T>>)
+    void
+    push_back(T&& element)
+    {
+        std::get<std::vector<std::remove_cvref_t<T>>>(segments_).push_back(std::forward<T>(element));
+    }
+
+        //
+        // Appends the alternative held by the given variant to the segment of its type. The alternative types of the variant must
+        // be a subset of the alternative types of the collection.
+        //
+    template <typename... Us>
+    void
+    push_back(std::variant<Us...> const& variant)
+    {
+        std::visit([this](auto const& element) { this->push_back(element); }, variant);
+    }
+    template <typename... Us>
+    void
+    push_back(std::variant<Us...>&& variant)
+    {
+        std::visit([this](auto&& element) { this->push_back(std::move(element)); }, std::move(variant));
+    }
+
+        //
+        // Calls the functor for every element, segment by segment in the order of the alternative types.
+        //
+    template <typename F>
+    void
+    for_each(F&& func)
+    {
+        (for_each_in_segment<Ts>(func), ...);
+    }
+    template <typename F>
+    void
+    for_each(F&& func) const
+    {
+        (for_each_in_segment<Ts>(func), ...);
+    }
+
+private:
+    template <typename T, typename F>
+    void
+    for_each_in_segment(F& func)
+    {
+        for (T& element : std::get<std::vector<T>>(segments_))
+        {
+            func(element);
+        }
+    }
+    template <typename T, typename F>
+    void
+    for_each_in_segment(F& func) const
+    {
+        for (T const& element : std::get<std::vector<T>>(segments_))
+        {
+            func(element);
+        }
+    }
+};
+
+    //
+    // Similar to `variant_transform()`: applies the functor to every element of the collection and returns a collection of the
+    // results, whose alternative types are the distinct non-void result types of the functor. Elements for which the functor
+    // returns `void` are dropped.
+    //ᅟ
+    //ᅟ    auto areas = variant_collection_transform(
+    //ᅟ        overload{
+    //ᅟ            [](Circle const& c) { return float(pi*c.r*c.r); },
+    //ᅟ            [](Rectangle const& r) { return double(r.w*r.h); }
+    //ᅟ        },
+    //ᅟ        shapes);  // returns `variant_collection<float, double>`
+    //
+template <typename F, typename... Ts>
+[[nodiscard]] typename detail::variant_collection_transform_result_<variant_collection, false, F, Ts...>::type
+variant_collection_transform(F&& func, variant_collection<Ts...> const& collection)
+{
+    auto result = typename detail::variant_collection_transform_result_<variant_collection, false, F, Ts...>::type{ };
+    ([&]
+    {
+        using R = std::remove_cvref_t<std::invoke_result_t<F&, Ts const&>>;
+        if constexpr (!std::is_void_v<R>)
+        {
+            result.template reserve<R>(detail::count_transform_results<R, F>(collection));
+        }
+    }(), ...);
+    collection.for_each(
+        [&func, &result]
+        (auto const& element)
+        {
+            if constexpr (std::is_void_v<std::invoke_result_t<F&, decltype(element)>>)
+            {
+                func(element);
+            }
+            else
+            {
+                result.push_back(func(element));
+            }
+        });
+    return result;
+}
+
+    //
+    // Similar to `variant_transform_many()`: applies the functor, which must return a variant, to every element of the collection
+    // and returns a collection whose alternative types are the distinct alternatives of all result variants.
+    //
+template <typename F, typename... Ts>
+[[nodiscard]] typename detail::variant_collection_transform_result_<variant_collection, true, F, Ts...>::type
+variant_collection_transform_many(F&& func, variant_collection<Ts...> const& collection)
+{
+    auto result = typename detail::variant_collection_transform_result_<variant_collection, true, F, Ts...>::type{ };
+    collection.for_each(
+        [&func, &result]
+        (auto const& element)
+        {
+            result.push_back(func(element));
+        });
+    return result;
+}
+
 
 } // namespace makeshift
 
@@ -0,0 +1,142 @@
+﻿
+#ifndef INCLUDED_MAKESHIFT_ISA_HPP_
+#define INCLUDED_MAKESHIFT_ISA_HPP_
+
+
+#include <array>
+#include <cstddef>      // for size_t
+#include <cstdlib>      // for getenv()
+#include <utility>      // for pair<>
+#include <variant>      // for visit()
+
+#include <gsl-lite/gsl-lite.hpp>  // for type_identity<>, gsl_Expects(), gsl_CPP20_OR_GREATER
+
+#if !gsl_CPP20_OR_GREATER
+# error makeshift requires C++20 mode or higher
+#endif // !gsl_CPP20_OR_GREATER
+
+#include <makeshift/variant.hpp>   // for expand()
+
+#include <makeshift/detail/isa.hpp>
+
+
+    //
+    // `MAKESHIFT_ISA_TARGET_SSE4_2`, `MAKESHIFT_ISA_TARGET_AVX2`, and `MAKESHIFT_ISA_TARGET_AVX512` permit the compiler to use
+    // the instructions of the given ISA level in the function they are attached to, regardless of the compiler flags. On
+    // compilers which do not support per-function targets, they expand to nothing, and the instruction set is governed by the
+    // compiler flags alone.
+    //ᅟ
+    //ᅟ    MAKESHIFT_ISA_TARGET_AVX2 void scale_avx2(std::span<float> v, float a);
+    //
+#if defined(__GNUC__) && MAKESHIFT_DETAIL_X86
+# define MAKESHIFT_ISA_TARGET_SSE4_2  __attribute__((target("sse4.2,popcnt")))
+# define MAKESHIFT_ISA_TARGET_AVX2    __attribute__((target("sse4.2,popcnt,avx2,fma,bmi,bmi2")))
+# define MAKESHIFT_ISA_TARGET_AVX512  __attribute__((target("sse4.2,popcnt,avx2,fma,bmi,bmi2,avx512f,avx512dq,avx512cd,avx512bw,avx512vl")))
+#else // defined(__GNUC__) && MAKESHIFT_DETAIL_X86
+# define MAKESHIFT_ISA_TARGET_SSE4_2
+# define MAKESHIFT_ISA_TARGET_AVX2
+# define MAKESHIFT_ISA_TARGET_AVX512
+#endif // defined(__GNUC__) && MAKESHIFT_DETAIL_X86
+
+
+namespace makeshift {
+
+namespace gsl = ::gsl_lite;
+
+
+    //
+    // Instruction set levels for which kernels can be specialized. Every level includes the preceding ones.
+    //
+    //     `scalar`: no particular instruction set extensions
+    //     `sse4_2`: SSE4.2 and POPCNT
+    //     `avx2`:   AVX2, FMA, BMI1, and BMI2
+    //     `avx512`: AVX-512 F, DQ, CD, BW, and VL
+    //
+enum class isa
+{
+    scalar,
+    sse4_2,
+    avx2,
+    avx512
+};
+constexpr auto
+reflect(gsl::type_identity<isa>)
+{
+    return std::array{
+        std::pair{ isa::scalar, "scalar" },
+        std::pair{ isa::sse4_2, "sse4.2" },
+        std::pair{ isa::avx2, "avx2" },
+        std::pair{ isa::avx512, "avx512" }
+    };
+}
+
+
+    //
+    // Returns the highest instruction set level supported by the current processor and operating system. The result is
+    // determined with `cpuid` upon the first call and cached.
+    //
+    // The level can be lowered by setting the environment variable `MAKESHIFT_ISA` to one of "scalar", "sse4.2", "avx2", or
+    // "avx512", which is useful for testing the kernels for lower levels on the same machine. An exception of type
+    // `std::runtime_error` is thrown if the environment variable holds an unknown value.
+    //
+[[nodiscard]] inline isa
+current_isa(void)
+{
+    static isa const value = detail::select_isa(detail::detect_isa<isa>(), std::getenv("MAKESHIFT_ISA"));
+    return value;
+}
+
+
+    //
+    // Calls the given function with a constval of type `isa` which holds the value of `current_isa()`. Kernels specialized
+    // for the individual levels can then be selected at compile time.
+    //ᅟ
+    //ᅟ    expand_isa(
+    //ᅟ        [&](auto isaC) {
+    //ᅟ            if constexpr (isaC() == isa::avx2) scale_avx2(v, a);
+    //ᅟ            else scale(v, a);
+    //ᅟ        });
+    //
+template <typename F>
+decltype(auto)
+expand_isa(F&& func)
+{
+    return std::visit(std::forward<F>(func), makeshift::expand(makeshift::current_isa()));
+}
+
+    //
+    // Calls the given function with a constval of type `isa` which holds the highest of the given levels that does not exceed
+    // `current_isa()`. At least one of the given levels must be supported, which is always the case if `isa::scalar` is
+    // among them.
+    //ᅟ
+    //ᅟ    expand_isa(
+    //ᅟ        [&](auto isaC) {
+    //ᅟ            if constexpr (isaC() == isa::avx2) scale_avx2(v, a);
+    //ᅟ            else scale(v, a);
+    //ᅟ        },
+    //ᅟ        MAKESHIFT_CONSTVAL(std::array{ isa::scalar, isa::avx2 }));
+    //
+template <typename F, typename IsasC>
+decltype(auto)
+expand_isa(F&& func, IsasC isasC)
+{
+    isa current = makeshift::current_isa();
+    bool found = false;
+    isa selected = isa::scalar;
+    for (isa level : isasC())
+    {
+        if (level <= current && (!found || level > selected))
+        {
+            selected = level;
+            found = true;
+        }
+    }
+    gsl_Expects(found);
+    return std::visit(std::forward<F>(func), makeshift::expand(selected, isasC));
+}
+
+
+} // namespace makeshift
+
+
+#endif // INCLUDED_MAKESHIFT_ISA_HPP_
@@ -0,0 +1,115 @@
+﻿
+#ifndef INCLUDED_MAKESHIFT_LUT_HPP_
+#define INCLUDED_MAKESHIFT_LUT_HPP_
+
+
+#include <array>
+#include <cstddef>      // for size_t, ptrdiff_t
+#include <utility>      // for index_sequence<>
+#include <type_traits>  // for invoke_result<>, decay<>
+
+#include <gsl-lite/gsl-lite.hpp>  // for gsl_Expects(), gsl_CPP20_OR_GREATER
+
+#if !gsl_CPP20_OR_GREATER
+# error makeshift requires C++20 mode or higher
+#endif // !gsl_CPP20_OR_GREATER
+
+#include <makeshift/variant.hpp>  // for detail::search_value_index()
+
+#include <makeshift/detail/lut.hpp>
+
+
+namespace makeshift {
+
+namespace gsl = ::gsl_lite;
+
+
+    //
+    // Lookup table which holds the results of a function for every combination of values in the domains `ValuesCs...`, which
+    // are constval arrays. Use `make_lut()` to create a lookup table.
+    //
+template <typename R, typename... ValuesCs>
+class lookup_table
+{
+    static_assert(sizeof...(ValuesCs) >= 1, "lookup table must have at least one domain");
+
+public:
+    using value_type = R;
+
+    static constexpr std::size_t rank = sizeof...(ValuesCs);
+    static constexpr std::size_t size = (detail::lut_domain_size_v<ValuesCs> * ... * std::size_t(1));
+
+private:
+    std::array<R, size> data_;
+
+public:
+    explicit constexpr lookup_table(std::array<R, size> const& _data)
+        : data_(_data)
+    {
+    }
+
+        //
+        // The table entries in row-major order.
+        //
+    [[nodiscard]] constexpr std::array<R, size> const&
+    data(void) const noexcept
+    {
+        return data_;
+    }
+
+        //
+        // Returns the table entry for the given combination of values. The index of every value in its domain is determined
+        // with the same search strategy as in `expand()`. All values must be elements of their respective domains.
+        //
+    [[nodiscard]] R const&
+    operator ()(detail::lut_domain_value_t<ValuesCs> const&... values) const
+    {
+        std::size_t index = 0;
+        ((index = index*detail::lut_domain_size_v<ValuesCs> + lookup_index<ValuesCs>(values)), ...);
+        return data_[index];
+    }
+
+private:
+    template <typename ValuesC>
+    static std::size_t
+    lookup_index(detail::lut_domain_value_t<ValuesC> const& value)
+    {
+        std::ptrdiff_t i = detail::search_value_index(value, ValuesC{ });
+        gsl_Expects(i >= 0);
+        return std::size_t(i);
+    }
+};
+
+
+    //
+    // Evaluates the given function for every combination of values in the given domains and returns a lookup table of the
+    // results. A domain is either a constval array of values or a `gsl::type_identity<T>`, which stands for all values of `T`
+    // as obtained by `metadata::values<T>()`. The result type of the function must be default-constructible. If the lookup
+    // table is declared `constinit` or `constexpr`, the function must be `constexpr` and is evaluated at compile time.
+    //ᅟ
+    //ᅟ    enum class Precision { single, double_ };
+    //ᅟ    constexpr auto reflect(gsl::type_identity<Precision>) { ... }
+    //ᅟ
+    //ᅟ    constinit auto const bytesPerVector = make_lut(
+    //ᅟ        [](Precision precision, int width) { return (precision == Precision::single ? 4 : 8)*width; },
+    //ᅟ        gsl::type_identity<Precision>{ }, MAKESHIFT_CONSTVAL(std::array{ 1, 4, 8, 16 }));
+    //ᅟ    int bytes = bytesPerVector(Precision::double_, 8);  // returns 64
+    //
+template <typename F, typename... DomainsT>
+[[nodiscard]] constexpr auto
+make_lut(F&& func, DomainsT... domains)
+{
+    static_assert(sizeof...(DomainsT) >= 1, "make_lut() requires at least one domain");
+
+    using Table = lookup_table<
+        std::decay_t<std::invoke_result_t<F&, detail::lut_domain_value_t<decltype(detail::lut_domain(domains))> const&...>>,
+        decltype(detail::lut_domain(domains))...>;
+    return Table(detail::make_lut_data<typename Table::value_type, decltype(detail::lut_domain(domains))...>(
+        std::make_index_sequence<sizeof...(DomainsT)>{ }, func));
+}
+
+
+} // namespace makeshift
+
+
+#endif // INCLUDED_MAKESHIFT_LUT_HPP_
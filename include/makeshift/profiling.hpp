@@ -0,0 +1,262 @@
+﻿
+#ifndef INCLUDED_MAKESHIFT_PROFILING_HPP_
+#define INCLUDED_MAKESHIFT_PROFILING_HPP_
+
+
+#include <vector>
+#include <atomic>
+#include <cstddef>          // for size_t, ptrdiff_t
+#include <cstdint>          // for uint_least64_t
+#include <variant>
+#include <optional>
+#include <ostream>
+#include <algorithm>        // for sort()
+#include <string_view>
+#include <type_traits>      // for is_void<>
+#include <source_location>
+
+#include <gsl-lite/gsl-lite.hpp>  // for type_identity<>, gsl_Expects(), gsl_CPP20_OR_GREATER
+
+#if !gsl_CPP20_OR_GREATER
+# error makeshift requires C++20 mode or higher
+#endif // !gsl_CPP20_OR_GREATER
+
+#include <makeshift/variant.hpp>   // for expand(), try_expand(), expand_failfast(), unsupported_runtime_value
+#include <makeshift/metadata.hpp>
+
+#include <makeshift/detail/profiling.hpp>
+
+
+    //
+    // Define `MAKESHIFT_DISPATCH_PROFILING` as 1 to have `MAKESHIFT_DISPATCH_SITE()` record dispatch frequencies. Otherwise,
+    // `MAKESHIFT_DISPATCH_SITE()` expands to a profiler which does nothing.
+    //
+#ifndef MAKESHIFT_DISPATCH_PROFILING
+# define MAKESHIFT_DISPATCH_PROFILING 0
+#endif // MAKESHIFT_DISPATCH_PROFILING
+
+    //
+    // Returns a dispatch profiler which identifies the current call site.
+    //ᅟ
+    //ᅟ    auto bitsV = expand(bits, MAKESHIFT_CONSTVAL(std::array{ 16, 32, 64 }), MAKESHIFT_DISPATCH_SITE());
+    //
+#if MAKESHIFT_DISPATCH_PROFILING
+# define MAKESHIFT_DISPATCH_SITE() (::makeshift::dispatch_profiler<decltype([]{ })>{ })
+#else // MAKESHIFT_DISPATCH_PROFILING
+# define MAKESHIFT_DISPATCH_SITE() (::makeshift::no_dispatch_profiler{ })
+#endif // MAKESHIFT_DISPATCH_PROFILING
+
+
+namespace makeshift {
+
+namespace gsl = ::gsl_lite;
+
+
+    //
+    // Policy type which makes `expand()`, `try_expand()`, and `expand_failfast()` count how often every alternative is hit.
+    // Counters are kept separately for every distinct site type `SiteT`; `dispatch_profiler<void>` does not count anything.
+    // The counters are updated with relaxed atomic operations and can be printed with `print_dispatch_profile()`.
+    //ᅟ
+    //ᅟ    auto colorV = expand(color, dispatch_profiler<struct color_site>{ });
+    //
+template <typename SiteT>
+class dispatch_profiler
+{
+private:
+    std::source_location location_;
+
+public:
+    constexpr dispatch_profiler(std::source_location location = std::source_location::current()) noexcept
+        : location_(location)
+    {
+    }
+
+        //
+        // The location at which the profiler was constructed.
+        //
+    [[nodiscard]] constexpr std::source_location const&
+    location(void) const noexcept
+    {
+        return location_;
+    }
+
+    template <typename ValuesC>
+    void
+    record(char const* function, std::ptrdiff_t index, ValuesC) const
+    {
+        if constexpr (!std::is_void_v<SiteT>)
+        {
+            detail::record_dispatch<SiteT, ValuesC>(location_, function, index);
+        }
+    }
+};
+
+    //
+    // Dispatch profiler which does not count anything.
+    //
+using no_dispatch_profiler = dispatch_profiler<void>;
+
+
+    //
+    // Equivalent to `expand_failfast(value, valuesC)`, and records the alternative hit with the given profiler.
+    //
+template <typename T, typename ValuesC, typename SiteT>
+[[nodiscard]] typename detail::constval_variant_map<std::variant, ValuesC>::type
+expand_failfast(T const& value, ValuesC valuesC, dispatch_profiler<SiteT> const& profiler)
+{
+    std::ptrdiff_t index = detail::search_value_index(value, valuesC);
+    profiler.record("expand_failfast", index, valuesC);
+    gsl_Expects(index >= 0);
+    return detail::constval_variant_map<std::variant, ValuesC>::values[index];
+}
+
+    //
+    // Equivalent to `expand_failfast(value)`, and records the alternative hit with the given profiler.
+    //
+template <typename T, typename SiteT>
+[[nodiscard]] auto
+expand_failfast(T const& value, dispatch_profiler<SiteT> const& profiler)
+{
+    if constexpr (metadata::is_available_v<decltype(metadata::values<T>())>)
+    {
+        return makeshift::expand_failfast(value, MAKESHIFT_CONSTVAL(metadata::values<T>()), profiler);
+    }
+    else
+    {
+        static_assert(!sizeof(gsl::type_identity<T>), "expand_failfast() cannot find admissible values");
+    }
+}
+
+    //
+    // Equivalent to `try_expand(value, valuesC)`, and records the alternative hit with the given profiler. Unsupported runtime
+    // values are counted separately.
+    //
+template <typename T, typename ValuesC, typename SiteT>
+[[nodiscard]] std::optional<typename detail::constval_variant_map<std::variant, ValuesC>::type>
+try_expand(T const& value, ValuesC valuesC, dispatch_profiler<SiteT> const& profiler)
+{
+    std::ptrdiff_t index = detail::search_value_index(value, valuesC);
+    profiler.record("try_expand", index, valuesC);
+    if (index < 0) return std::nullopt;
+    return { detail::constval_variant_map<std::variant, ValuesC>::values[index] };
+}
+
+    //
+    // Equivalent to `try_expand(value)`, and records the alternative hit with the given profiler.
+    //
+template <typename T, typename SiteT>
+[[nodiscard]] auto
+try_expand(T const& value, dispatch_profiler<SiteT> const& profiler)
+{
+    if constexpr (metadata::is_available_v<decltype(metadata::values<T>())>)
+    {
+        return makeshift::try_expand(value, MAKESHIFT_CONSTVAL(metadata::values<T>()), profiler);
+    }
+    else
+    {
+        static_assert(!sizeof(gsl::type_identity<T>), "try_expand() cannot find admissible values");
+    }
+}
+
+    //
+    // Equivalent to `expand(value, valuesC)`, and records the alternative hit with the given profiler. Unsupported runtime
+    // values are counted separately.
+    //
+template <typename T, typename ValuesC, typename SiteT>
+[[nodiscard]] typename detail::constval_variant_map<std::variant, ValuesC>::type
+expand(T const& value, ValuesC valuesC, dispatch_profiler<SiteT> const& profiler)
+{
+    std::ptrdiff_t index = detail::search_value_index(value, valuesC);
+    profiler.record("expand", index, valuesC);
+    if (index < 0) throw unsupported_runtime_value{ };
+    return detail::constval_variant_map<std::variant, ValuesC>::values[index];
+}
+
+    //
+    // Equivalent to `expand(value)`, and records the alternative hit with the given profiler.
+    //
+template <typename T, typename SiteT>
+[[nodiscard]] auto
+expand(T const& value, dispatch_profiler<SiteT> const& profiler)
+{
+    if constexpr (metadata::is_available_v<decltype(metadata::values<T>())>)
+    {
+        return makeshift::expand(value, MAKESHIFT_CONSTVAL(metadata::values<T>()), profiler);
+    }
+    else
+    {
+        static_assert(!sizeof(gsl::type_identity<T>), "expand() cannot find admissible values");
+    }
+}
+
+
+    //
+    // Prints the dispatch frequencies recorded by all profiled call sites hit so far, ordered by source location. Alternatives
+    // are printed by name if names are available through `metadata::value_names<>()`.
+    //ᅟ
+    //ᅟ    print_dispatch_profile(std::cerr);
+    //ᅟ    // prints:
+    //ᅟ    // render.cpp:42: expand() in 'void render(const Scene&)'
+    //ᅟ    //     red: 1042
+    //ᅟ    //     green: 0
+    //ᅟ    //     blue: 17
+    //
+inline void
+print_dispatch_profile(std::ostream& stream)
+{
+    auto sites = std::vector<detail::dispatch_profile_site const*>{ };
+    for (auto site = detail::dispatch_profile_sites.load(std::memory_order_acquire); site != nullptr; site = site->next)
+    {
+        sites.push_back(site);
+    }
+    std::sort(sites.begin(), sites.end(),
+        [](detail::dispatch_profile_site const* lhs, detail::dispatch_profile_site const* rhs)
+        {
+            auto lhsFile = std::string_view(lhs->location.file_name());
+            auto rhsFile = std::string_view(rhs->location.file_name());
+            if (lhsFile != rhsFile) return lhsFile < rhsFile;
+            return lhs->location.line() < rhs->location.line();
+        });
+
+    for (auto site : sites)
+    {
+        stream << site->location.file_name() << ':' << site->location.line() << ": " << site->function << "()";
+        if (*site->location.function_name() != '\0')
+        {
+            stream << " in '" << site->location.function_name() << '\'';
+        }
+        stream << '\n';
+        for (std::size_t i = 0; i != site->numAlternatives; ++i)
+        {
+            stream << "    ";
+            site->printAlternative(stream, i);
+            stream << ": " << site->hits[i].load(std::memory_order_relaxed) << '\n';
+        }
+        auto numUnsupported = site->hits[site->numAlternatives].load(std::memory_order_relaxed);
+        if (numUnsupported != 0)
+        {
+            stream << "    (unsupported): " << numUnsupported << '\n';
+        }
+    }
+}
+
+    //
+    // Resets the dispatch frequencies recorded by all profiled call sites to zero.
+    //
+inline void
+reset_dispatch_profile(void)
+{
+    for (auto site = detail::dispatch_profile_sites.load(std::memory_order_acquire); site != nullptr; site = site->next)
+    {
+        for (std::size_t i = 0; i != site->numAlternatives + 1; ++i)
+        {
+            site->hits[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+
+} // namespace makeshift
+
+
+#endif // INCLUDED_MAKESHIFT_PROFILING_HPP_
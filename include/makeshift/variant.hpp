@@ -5,7 +5,9 @@
 
 #include <cstddef>      // for ptrdiff_t
 #include <utility>      // for forward<>()
+#include <span>
 #include <variant>
+#include <concepts>     // for same_as<>
 #include <optional>
 #include <type_traits>  // for remove_cv<>, remove_reference<>, invoke_result<>
 
@@ -191,9 +193,168 @@ expand(T const& value)
     }
 }
 
+    //
+    // Compact representation of a variant of known constexpr values, as returned by `expand()`. Only the index of the
+    // alternative is stored, using the smallest sufficient unsigned integer type, so `constval_variant<>` is trivially copyable
+    // and suitable for storing in large arrays. It converts to the corresponding `std::variant<>` on demand and can be passed to
+    // `visit()`, which dispatches over the alternatives with a `switch` statement if their number is small.
+    //ᅟ
+    //ᅟ    auto bitsV = expand_compact(bits, MAKESHIFT_CONSTVAL(std::array{ 16, 32, 64 }));
+    //ᅟ    static_assert(sizeof(bitsV) == 1);
+    //ᅟ
+    //ᅟ    visit(
+    //ᅟ        [](auto bitsC) {
+    //ᅟ            constexpr int bits = bitsC();
+    //ᅟ            ...
+    //ᅟ        },
+    //ᅟ        bitsV);
+    //
+template <typename ValuesC>
+class constval_variant
+{
+private:
+    using index_type = detail::constval_variant_index_t<ValuesC::value.size()>;
+
+    index_type index_ = 0;
+
+public:
+    using variant_type = typename detail::constval_variant_type_<std::variant, ValuesC>::type;
+    using value_type = typename ValuesC::element_type;
+
+    constexpr constval_variant(void) noexcept = default;
+        // The conversions from and to `variant_type` are templates so that copying a `constval_variant<>` or checking for other
+        // implicit conversions does not require `variant_type` to be complete.
+    template <std::same_as<variant_type> V>
+    constexpr constval_variant(V const& variant) noexcept
+        : index_(index_type(variant.index()))
+    {
+    }
+
+        //
+        // Constructs a `constval_variant<>` which holds the alternative with the given index.
+        //
+    [[nodiscard]] static constexpr constval_variant
+    from_index(std::size_t index)
+    {
+        gsl_Expects(index < ValuesC::value.size());
+
+        auto result = constval_variant{ };
+        result.index_ = index_type(index);
+        return result;
+    }
+
+        //
+        // The index of the alternative held.
+        //
+    [[nodiscard]] constexpr std::size_t
+    index(void) const noexcept
+    {
+        return index_;
+    }
+
+        //
+        // The value of the alternative held.
+        //
+    [[nodiscard]] constexpr value_type
+    value(void) const noexcept
+    {
+        return ValuesC::value[index_];
+    }
+
+    template <std::same_as<variant_type> V>
+    [[nodiscard]] constexpr
+    operator V(void) const noexcept
+    {
+        return detail::constval_variant_map<std::variant, ValuesC>::values[index_];
+    }
+
+    [[nodiscard]] friend constexpr bool operator ==(constval_variant, constval_variant) noexcept = default;
+};
+
+    //
+    // Returns the `I`-th alternative of the given `constval_variant<>`. Throws `std::bad_variant_access` if the variant does not
+    // hold the `I`-th alternative.
+    //
+template <std::size_t I, typename ValuesC>
+[[nodiscard]] constexpr typename detail::nth_array_constant_<I, ValuesC>::type
+get(constval_variant<ValuesC> const& variant)
+{
+    if (variant.index() != I) throw std::bad_variant_access{ };
+    return { };
+}
+
+    //
+    // Given a runtime value and a constexpr array of values, `expand_compact()` returns a `constval_variant<>` of known constexpr
+    // values. An exception of type `unsupported_runtime_value` is thrown if the runtime value is not among the values in the
+    // array.
+    //
+template <typename T, typename ValuesC>
+[[nodiscard]] constexpr constval_variant<ValuesC>
+expand_compact(T const& value, ValuesC valuesC)
+{
+    std::ptrdiff_t index = detail::search_value_index(value, valuesC);
+    if (index < 0) throw unsupported_runtime_value{ };
+    return constval_variant<ValuesC>::from_index(std::size_t(index));
+}
 
     //
-    // Equivalent to `std::visit()`.
+    // Given a runtime value of a type for which all possible values are known, `expand_compact()` returns a
+    // `constval_variant<>` of known constexpr values. An exception of type `unsupported_runtime_value` is thrown if the runtime
+    // value is not among the values in the array.
+    //
+template <typename T>
+[[nodiscard]] constexpr auto
+expand_compact(T const& value)
+{
+    if constexpr (metadata::is_available_v<decltype(metadata::values<T>())>)
+    {
+        return makeshift::expand_compact(value, MAKESHIFT_CONSTVAL(metadata::values<T>()));
+    }
+    else
+    {
+        static_assert(!sizeof(gsl::type_identity<T>), "expand_compact() cannot find admissible values");
+    }
+}
+
+
+    //
+    // Given a list of runtime values followed by a list of constexpr arrays of values, `expand_all()` returns a variant of tuples
+    // of known constexpr values which covers all combinations of values. The index of the combination is computed with
+    // mixed-radix arithmetic from the indices of the individual values, so visiting the result requires a single dispatch
+    // regardless of the number of values. An exception of type `unsupported_runtime_value` is thrown if one of the runtime
+    // values is not among the values in the corresponding array.
+    //ᅟ
+    //ᅟ    int bits = ...;
+    //ᅟ    bool logging = ...;
+    //ᅟ    auto paramsV = expand_all(bits, logging,
+    //ᅟ        MAKESHIFT_CONSTVAL(std::array{ 16, 32, 64 }), MAKESHIFT_CONSTVAL(std::array{ false, true }));
+    //ᅟ
+    //ᅟ    visit(
+    //ᅟ        [](auto paramsC) {
+    //ᅟ            std::apply(
+    //ᅟ                [](auto bitsC, auto loggingC) {
+    //ᅟ                    constexpr int bits = bitsC();
+    //ᅟ                    ...
+    //ᅟ                },
+    //ᅟ                paramsC);
+    //ᅟ        },
+    //ᅟ        paramsV);
+    //
+template <typename... Args>
+[[nodiscard]] constexpr auto
+expand_all(Args const&... args)
+{
+    auto [values, valuesCs] = detail::split_expand_all_args(args...);
+    using Map = detail::expand_all_map_<decltype(valuesCs)>;
+    std::ptrdiff_t index = detail::search_value_linear_index(typename Map::strides{ }, values, valuesCs, std::make_index_sequence<sizeof...(Args) / 2>{ });
+    if (index < 0) throw unsupported_runtime_value{ };
+    return Map::map::values[index];
+}
+
+    //
+    // Equivalent to `std::visit()`. The combination of alternatives held by the variants is mapped to a linear index, which is
+    // dispatched with a single indirect call or `switch` statement regardless of the number of variants. Arguments may also be
+    // of type `constval_variant<>`.
     //ᅟ
     // Suppresses any template instantiations for intellisense parsers to improve responsivity.
     //
@@ -201,13 +362,36 @@ template <typename F, typename... Vs>
 [[nodiscard]] constexpr auto
 visit(F&& func, Vs&&... args)
 #if !defined(__INTELLISENSE__)
-    -> decltype(std::visit(std::forward<F>(func), std::forward<Vs>(args)...))
+    -> detail::visit_result_t<F, Vs...>
 #endif // !defined(__INTELLISENSE__)
 {
 #if defined(__INTELLISENSE__)
     return detail::convertible_to_anything{ };
 #else
-    return std::visit(std::forward<F>(func), std::forward<Vs>(args)...);
+    return detail::visit<detail::visit_result_t<F, Vs...>, true, visit_dispatch::automatic>(std::forward<F>(func), std::forward<Vs>(args)...);
+#endif // defined(__INTELLISENSE__)
+}
+
+    //
+    // Equivalent to `std::visit()`, using the given dispatch strategy.
+    //ᅟ
+    //ᅟ    visit<visit_dispatch::switch_statement>(
+    //ᅟ        [](auto bitsC, auto loggingC) { ... },
+    //ᅟ        bitsV, loggingV);
+    //ᅟ
+    // Suppresses any template instantiations for intellisense parsers to improve responsivity.
+    //
+template <visit_dispatch Dispatch, typename F, typename... Vs>
+[[nodiscard]] constexpr auto
+visit(F&& func, Vs&&... args)
+#if !defined(__INTELLISENSE__)
+    -> detail::visit_result_t<F, Vs...>
+#endif // !defined(__INTELLISENSE__)
+{
+#if defined(__INTELLISENSE__)
+    return detail::convertible_to_anything{ };
+#else
+    return detail::visit<detail::visit_result_t<F, Vs...>, true, Dispatch>(std::forward<F>(func), std::forward<Vs>(args)...);
 #endif // defined(__INTELLISENSE__)
 }
 
@@ -223,10 +407,97 @@ visit(F&& func, Vs&&... args)
 #if defined(__INTELLISENSE__)
     return detail::convertible_to_anything{ };
 #else
-    return std::visit<R>(std::forward<F>(func), std::forward<Vs>(args)...);
+    return detail::visit<R, false, visit_dispatch::automatic>(std::forward<F>(func), std::forward<Vs>(args)...);
 #endif // !defined(__INTELLISENSE__)
 }
 
+    //
+    // Equivalent to `std::visit<>()`, using the given dispatch strategy.
+    //ᅟ
+    // Suppresses any template instantiations for intellisense parsers to improve responsivity.
+    //
+template <typename R, visit_dispatch Dispatch, typename F, typename... Vs>
+[[nodiscard]] constexpr R
+visit(F&& func, Vs&&... args)
+{
+#if defined(__INTELLISENSE__)
+    return detail::convertible_to_anything{ };
+#else
+    return detail::visit<R, false, Dispatch>(std::forward<F>(func), std::forward<Vs>(args)...);
+#endif // !defined(__INTELLISENSE__)
+}
+
+
+    //
+    // Given a functor, a runtime value, and a constexpr array of values for which a specialization is desired, calls the functor
+    // with a constval if the runtime value is among the values in the array, and with the runtime value otherwise. If the value
+    // is a `std::tuple<>`, the functor is called with the tuple elements as separate arguments, i.e. with a list of constvals or
+    // with a list of runtime values. This way, specialized code is instantiated only for a sparse set of "hot" combinations of
+    // values rather than for the full Cartesian product, and any other combination is handled by the generic implementation.
+    // The result type of the functor must be the same for constval and runtime arguments, or convertible to the latter.
+    //ᅟ
+    //ᅟ    int bits = ...;
+    //ᅟ    bool logging = ...;
+    //ᅟ    visit_specialized(
+    //ᅟ        [](auto bits, auto logging) {
+    //ᅟ            // `bits` and `logging` are either constvals or runtime values
+    //ᅟ            ...
+    //ᅟ        },
+    //ᅟ        std::tuple{ bits, logging },
+    //ᅟ        MAKESHIFT_CONSTVAL(std::array{ std::tuple{ 32, false }, std::tuple{ 64, false } }));
+    //
+template <typename F, typename T, typename ValuesC>
+[[nodiscard]] constexpr decltype(auto)
+visit_specialized(F&& func, T const& value, ValuesC valuesC)
+{
+    using R = decltype(detail::invoke_unpacked(func, value));
+    auto valueVO = makeshift::try_expand(value, valuesC);
+    if (valueVO.has_value())
+    {
+        return makeshift::visit<R>(
+            [&func]
+            (auto valueC) -> R
+            {
+                return detail::invoke_unpacked(func, valueC);
+            },
+            *valueVO);
+    }
+    return detail::invoke_unpacked(func, value);
+}
+
+
+    //
+    // Given a functor, a contiguous range of items, and a list of projections which map an item to a variant of constvals (e.g.
+    // as returned by `expand()` or `expand_compact()`), `visit_batched()` groups the items by the combination of alternatives
+    // and calls the functor once for every non-empty group, passing a span of the items in the group followed by the constvals.
+    // Thus, every specialization is executed once for a contiguous batch of items rather than in interleaved order, which is
+    // kinder to the branch predictor and the instruction cache. The items are grouped with a stable counting sort over the
+    // finite set of combinations of alternatives, and the range of items is reordered accordingly.
+    //ᅟ
+    //ᅟ    struct WorkItem { constval_variant<decltype(bitsValuesC)> bitsV; bool logging; ... };
+    //ᅟ    std::vector<WorkItem> items = ...;
+    //ᅟ    visit_batched(
+    //ᅟ        [](std::span<WorkItem> batch, auto bitsC, auto loggingC) {
+    //ᅟ            for (WorkItem& item : batch) { ... }
+    //ᅟ        },
+    //ᅟ        items,
+    //ᅟ        [](WorkItem const& item) { return item.bitsV; },
+    //ᅟ        [](WorkItem const& item) { return expand(item.logging); });
+    //
+template <typename F, typename ItemsT, typename... ProjectionsT>
+void
+visit_batched(F&& func, ItemsT&& items, ProjectionsT&&... projections)
+{
+    static_assert(sizeof...(ProjectionsT) > 0, "visit_batched() requires at least one projection");
+
+    auto itemSpan = std::span(items);
+    using T = typename decltype(itemSpan)::element_type;
+    using Shape = std::integer_sequence<std::ptrdiff_t,
+        std::ptrdiff_t(detail::variant_size_<detail::as_variant_t<std::invoke_result_t<ProjectionsT&, T&>>>::value)...>;
+    constexpr bool useSwitch = std::size_t(detail::compute_size_<Shape>::value) <= detail::max_switch_dispatch_size;
+    detail::visit_batched_impl<useSwitch>(Shape{ }, detail::compute_strides_t<Shape>{ }, func, itemSpan, projections...);
+}
+
 
     //
     // Similar to `std::visit()`, but permits the functor to map different argument types to different result types and returns a
@@ -253,7 +524,7 @@ variant_transform(F&& func, Vs&&... args)
     return detail::convertible_to_anything{ };
 #else
     using R = detail::variant_transform_result<std::variant, F, Vs...>;
-    return std::visit<R>
+    return detail::visit<R, false, visit_dispatch::automatic>
     (
         [&func]
         (auto&&... args) -> R
@@ -291,11 +562,11 @@ variant_transform_many(F&& func, Vs&&... args)
     return detail::convertible_to_anything{ };
 #else
     using R = detail::variant_transform_many_result<std::variant, F, Vs...>;
-    return std::visit<R>(
+    return detail::visit<R, false, visit_dispatch::automatic>(
         [func = std::forward<F>(func)]
         (auto&&... args) -> R
         {
-            return std::visit<R>(
+            return detail::visit<R, false, visit_dispatch::automatic>(
                 [](auto&& result) -> R
                 {
                     return std::forward<decltype(result)>(result);
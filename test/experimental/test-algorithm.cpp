@@ -1,4 +1,17 @@
 
+#include <map>
+#include <atomic>
+#include <list>
+#include <deque>
+#include <vector>
+#include <random>
+#include <numeric>     // for iota()
+#include <algorithm>   // for sort(), count(), find()
+#include <stdexcept>   // for runtime_error
+#include <functional>  // for plus<>, identity
+
+#include <makeshift/algorithm.hpp>
+#include <makeshift/experimental/span.hpp>
 #include <makeshift/experimental/algorithm.hpp>
 
 #include <gsl-lite/gsl-lite.hpp>
@@ -12,7 +25,358 @@ namespace mk = ::makeshift;
 namespace gsl = ::gsl_lite;
 
 
-// TODO: add tests
+TEST_CASE("apply_permutation_nondestructive()")
+{
+    auto rng = std::mt19937_64{ 42 };
+
+    SECTION("small range")
+    {
+        auto v = std::vector<int>{ 10, 11, 12, 13, 14 };
+        auto indices = std::vector<int>{ 3, 0, 4, 1, 2 };
+        mk::apply_permutation_nondestructive(v.begin(), v.end(), indices.begin());
+        CHECK(v == std::vector<int>{ 13, 10, 14, 11, 12 });
+        CHECK(indices == std::vector<int>{ 3, 0, 4, 1, 2 });
+
+        auto w = std::vector<int>{ 10, 11, 12, 13, 14 };
+        auto wIndices = indices;
+        mk::apply_permutation(w.begin(), w.end(), wIndices.begin());
+        CHECK(w == v);
+    }
+    SECTION("large range")
+    {
+        gsl::dim n = 100000;  // exceeds the threshold for gathering
+        auto indices = std::vector<gsl::index>(n);
+        std::iota(indices.begin(), indices.end(), gsl::index(0));
+        mk::shuffle(indices.begin(), indices.end(), rng);
+        auto v = std::vector<gsl::index>(n);
+        std::iota(v.begin(), v.end(), gsl::index(0));
+        auto originalIndices = indices;
+        mk::apply_permutation_nondestructive(v.begin(), v.end(), indices.begin());
+        CHECK(indices == originalIndices);
+        CHECK(v == indices);
+    }
+    SECTION("proxy iterators")
+    {
+        auto flags = std::vector<bool>{ true, false, false };
+        auto indices = std::array{ 1, 2, 0 };
+        mk::apply_permutation_nondestructive(flags.begin(), flags.end(), indices.begin());
+        CHECK(flags == std::vector<bool>{ false, false, true });
+    }
+    SECTION("error when indices do not form a permutation")
+    {
+        auto v = std::vector<int>{ 10, 11, 12 };
+        auto indices = std::vector<int>{ 1, 1, 0 };
+        CHECK_THROWS(mk::apply_permutation_nondestructive(v.begin(), v.end(), indices.begin()));
+        auto indices2 = std::vector<int>{ 1, 3, 0 };
+        CHECK_THROWS(mk::apply_permutation_nondestructive(v.begin(), v.end(), indices2.begin()));
+
+        gsl::dim n = 100000;  // exceeds the threshold for gathering
+        auto w = std::vector<gsl::index>(n);
+        auto wIndices = std::vector<gsl::index>(n);
+        std::iota(wIndices.begin(), wIndices.end(), gsl::index(0));
+        wIndices[n - 1] = 0;
+        CHECK_THROWS(mk::apply_permutation_nondestructive(w.begin(), w.end(), wIndices.begin()));
+    }
+    SECTION("parallel, multiple columns")
+    {
+        gsl::dim n = 1000;
+        auto indices = std::vector<gsl::index>(n);
+        std::iota(indices.begin(), indices.end(), gsl::index(0));
+        mk::shuffle(indices.begin(), indices.end(), rng);
+        auto xs = std::vector<int>(n);
+        auto ys = std::vector<double>(n);
+        auto zs = std::vector<long>(n);
+        for (gsl::index i = 0; i != n; ++i)
+        {
+            xs[i] = int(i);
+            ys[i] = double(i);
+            zs[i] = long(i);
+        }
+        auto particles = mk::soa_span(gsl::span(xs), gsl::span(ys), gsl::span(zs));
+        mk::apply_permutation_nondestructive(mk::parallel_policy{ 2, 16 }, particles, indices.begin());
+        for (gsl::index i = 0; i != n; ++i)
+        {
+            if (xs[i] != indices[i] || ys[i] != double(indices[i]) || zs[i] != long(indices[i]))
+            {
+                FAIL_CHECK("element " << i << " was not permuted correctly");
+            }
+        }
+    }
+}
+
+TEST_CASE("parallel range_fill(), range_iota(), range_generate()")
+{
+    auto policy = mk::parallel_policy{ 4, 16 };
+
+    SECTION("basic use")
+    {
+        auto vec = std::vector<long>(1000);
+        mk::range_iota(policy, vec, 10L);
+        for (gsl::index i = 0; i != gsl::ssize(vec); ++i)
+        {
+            if (vec[i] != i + 10) FAIL("vec[" << i << "] == " << vec[i]);
+        }
+        mk::range_fill(policy, vec, 3L);
+        CHECK(std::count(vec.begin(), vec.end(), 3L) == 1000);
+        mk::range_generate(policy, vec, [] { return -1L; });
+        CHECK(std::count(vec.begin(), vec.end(), -1L) == 1000);
+    }
+    SECTION("non-contiguous ranges")
+    {
+        auto deque = std::deque<int>(100);
+        mk::range_iota(policy, deque, 0);
+        CHECK(deque[0] == 0);
+        CHECK(deque[50] == 50);
+        CHECK(deque[99] == 99);
+    }
+    SECTION("large ranges")
+    {
+        auto vec = std::vector<double>((std::size_t(1) << 19) + 13);
+        mk::range_iota(policy, vec, 0.);
+        for (gsl::index i = 0; i != gsl::ssize(vec); ++i)
+        {
+            if (vec[i] != double(i)) FAIL("vec[" << i << "] == " << vec[i]);
+        }
+    }
+}
+
+TEST_CASE("parallel range_find_if(), range_any_of(), range_all_of(), range_none_of()")
+{
+    auto policy = mk::parallel_policy{ 4, 16 };
+
+    auto xs = std::vector<int>(100000);
+    std::iota(xs.begin(), xs.end(), 0);
+    auto ys = std::vector<int>(xs.size(), 1);
+
+    SECTION("range_find_if() returns the lowest matching index")
+    {
+        ys[70000] = -1;
+        ys[20000] = -1;
+        ys[90000] = -1;
+        CHECK(mk::range_find_if(policy, [](int y) { return y < 0; }, ys) == 20000);
+        CHECK(mk::range_find_if(policy, [](int x, int y) { return x > 30000 && y < 0; }, xs, ys) == 70000);
+        CHECK(mk::range_find_if(policy, [](gsl::index i, int x) { return gsl::index(x) != i; }, mk::range_index, xs) == -1);
+    }
+    SECTION("range_any_of(), range_all_of(), range_none_of()")
+    {
+        CHECK(mk::range_all_of(policy, [](int y) { return y == 1; }, ys));
+        CHECK(mk::range_none_of(policy, [](int x, int y) { return x + y == 0; }, xs, ys));
+        CHECK_FALSE(mk::range_any_of(policy, [](int x) { return x < 0; }, xs));
+        ys[99999] = 0;
+        CHECK_FALSE(mk::range_all_of(policy, [](int y) { return y == 1; }, ys));
+        CHECK(mk::range_any_of(policy, [](int y) { return y == 0; }, ys));
+        CHECK_FALSE(mk::range_none_of(policy, [](int x, int y) { return x*y == 0 && x != 0; }, xs, ys));
+    }
+    SECTION("workers stop early")
+    {
+        auto numCalls = std::atomic<gsl::dim>(0);
+        CHECK(mk::range_any_of(policy,
+            [&numCalls](int x)
+            {
+                ++numCalls;
+                return x == 0;
+            },
+            xs));
+        CHECK(numCalls.load() < gsl::dim(xs.size()));
+    }
+    SECTION("small ranges are searched sequentially")
+    {
+        auto small = std::vector<int>{ 3, 1, 2 };
+        CHECK(mk::range_find_if(policy, [](int x) { return x < 3; }, small) == 1);
+    }
+    SECTION("error when trying to combine ranges with different sizes")
+    {
+        auto zs = std::vector<int>(xs.size() + 1);
+        CHECK_THROWS(mk::range_any_of(policy, [](int, int) { return false; }, xs, zs));
+    }
+}
+
+TEST_CASE("parallel range_inclusive_scan()")
+{
+    auto policy = mk::parallel_policy{ 4, 16 };
+
+    auto counts = std::vector<long>(1000);
+    std::iota(counts.begin(), counts.end(), 1L);
+    auto expected = std::vector<long>(counts.size());
+    long expectedTotal = mk::range_inclusive_scan(7L, std::plus<>{ }, std::identity{ }, expected, counts);
+
+    SECTION("basic use")
+    {
+        auto out = std::vector<long>(counts.size());
+        long total = mk::range_inclusive_scan(policy, 7L, std::plus<>{ }, std::identity{ }, out, counts);
+        CHECK(total == expectedTotal);
+        CHECK(out == expected);
+    }
+    SECTION("in-place")
+    {
+        long total = mk::range_inclusive_scan(policy, 7L, std::plus<>{ }, std::identity{ }, counts, counts);
+        CHECK(total == expectedTotal);
+        CHECK(counts == expected);
+    }
+    SECTION("small ranges are scanned sequentially")
+    {
+        auto small = std::vector<long>{ 1, 2, 3 };
+        long total = mk::range_inclusive_scan(policy, 0L, std::plus<>{ }, std::identity{ }, small, small);
+        CHECK(total == 6);
+        CHECK(small == std::vector<long>{ 1, 3, 6 });
+    }
+    SECTION("exceptions are propagated")
+    {
+        auto out = std::vector<long>(counts.size());
+        CHECK_THROWS_AS(
+            mk::range_inclusive_scan(policy, 0L, std::plus<>{ },
+                [](gsl::index i, long x)
+                {
+                    if (i == 999) throw std::runtime_error("error");
+                    return x;
+                },
+                out, mk::range_index, counts),
+            std::runtime_error);
+    }
+}
+
+TEST_CASE("parallel range_exclusive_scan()")
+{
+    auto policy = mk::parallel_policy{ 3, 10 };
+
+    auto flags = std::vector<int>(500);
+    for (gsl::index i = 0; i != 500; ++i)
+    {
+        flags[i] = i % 3 == 0;
+    }
+    auto expected = std::vector<int>(flags.size());
+    int expectedTotal = mk::range_exclusive_scan(0, std::plus<>{ }, std::identity{ }, expected, flags);
+
+    auto out = std::vector<int>(flags.size());
+    int total = mk::range_exclusive_scan(policy, 0, std::plus<>{ }, std::identity{ }, out, flags);
+    CHECK(total == expectedTotal);
+    CHECK(total == 167);
+    CHECK(out == expected);
+}
+
+TEST_CASE("parallel range_copy_if()")
+{
+    auto policy = mk::parallel_policy{ 4, 16 };
+
+    auto xs = std::vector<int>(1000);
+    auto ys = std::vector<double>(1000);
+    for (gsl::index i = 0; i != 1000; ++i)
+    {
+        xs[i] = int(i);
+        ys[i] = 0.5*double(i);
+    }
+    auto isAlive = [](int x, double) { return x % 7 != 0; };
+
+    SECTION("soa_span")
+    {
+        auto particles = mk::soa_span(gsl::span(xs), gsl::span(ys));
+        auto outXs = std::vector<int>(1000);
+        auto outYs = std::vector<double>(1000);
+        auto alive = mk::soa_span(gsl::span(outXs), gsl::span(outYs));
+        auto n = mk::range_copy_if(policy, [&](auto&& p) { return isAlive(get<0>(p), get<1>(p)); }, alive, particles);
+        CHECK(n == 1000 - 143);
+        auto expectedXs = std::vector<int>(1000);
+        auto expectedYs = std::vector<double>(1000);
+        auto expectedN = mk::range_copy_if(isAlive, mk::range_zip(expectedXs, expectedYs), xs, ys);
+        CHECK(n == expectedN);
+        CHECK(outXs == expectedXs);
+        CHECK(outYs == expectedYs);
+    }
+    SECTION("exact output size")
+    {
+        auto outXs = std::vector<int>(1000 - 143);
+        auto n = mk::range_copy_if(policy, [](int x) { return x % 7 != 0; }, outXs, xs);
+        CHECK(n == 1000 - 143);
+        CHECK(outXs.front() == 1);
+        CHECK(outXs.back() == 999);
+    }
+    SECTION("error when output range is too small")
+    {
+        auto outXs = std::vector<int>(10);
+        CHECK_THROWS(mk::range_copy_if(policy, [](int x) { return x % 7 != 0; }, outXs, xs));
+    }
+}
+
+TEST_CASE("parallel shuffle()")
+{
+    SECTION("result is a permutation")
+    {
+        auto rng = std::mt19937_64{ 42 };
+        for (gsl::dim n : { 0, 1, 2, 3, 10, 1001 })
+        {
+            auto v = std::vector<int>(n);
+            std::iota(v.begin(), v.end(), 0);
+            auto vs = v;
+            mk::shuffle(mk::parallel_policy{ 4, 2 }, vs.begin(), vs.end(), rng);
+            std::sort(vs.begin(), vs.end());
+            CHECK(vs == v);
+        }
+    }
+    SECTION("permutations are uniformly distributed")
+    {
+        auto rng = std::mt19937{ 42 };
+        auto counts = std::map<std::array<int, 4>, int>{ };
+        constexpr int numTrials = 12000;
+        for (int i = 0; i != numTrials; ++i)
+        {
+            auto v = std::array{ 0, 1, 2, 3 };
+            mk::shuffle(mk::parallel_policy{ 2, 1 }, v.begin(), v.end(), rng);
+            ++counts[v];
+        }
+        CHECK(counts.size() == 24);
+        for (auto const& [perm, count] : counts)
+        {
+            (void) perm;
+            CHECK(count > numTrials/24*8/10);
+            CHECK(count < numTrials/24*12/10);
+        }
+    }
+    SECTION("blocks of different sizes")
+    {
+        auto rng = std::mt19937_64{ 42 };
+        auto firstPositions = std::array<int, 5>{ };
+        auto lastPositions = std::array<int, 5>{ };
+        constexpr int numTrials = 30000;
+        for (int i = 0; i != numTrials; ++i)
+        {
+            auto v = std::array{ 0, 1, 2, 3, 4 };
+            mk::shuffle(mk::parallel_policy{ 3, 1 }, v.begin(), v.end(), rng);
+            ++firstPositions[std::find(v.begin(), v.end(), 0) - v.begin()];
+            ++lastPositions[std::find(v.begin(), v.end(), 4) - v.begin()];
+        }
+        for (gsl::index i = 0; i != 5; ++i)
+        {
+            CHECK(firstPositions[i] > numTrials/5*95/100);
+            CHECK(firstPositions[i] < numTrials/5*105/100);
+            CHECK(lastPositions[i] > numTrials/5*95/100);
+            CHECK(lastPositions[i] < numTrials/5*105/100);
+        }
+    }
+    SECTION("proxy iterators")
+    {
+        auto rng = std::mt19937_64{ 42 };
+        auto flags = std::vector<bool>(1000);
+        auto xs = std::vector<int>(1000);
+        auto ys = std::vector<int>(1000);
+        for (gsl::index i = 0; i != 1000; ++i)
+        {
+            flags[i] = i % 3 == 0;
+            xs[i] = int(i);
+            ys[i] = -int(i);
+        }
+        mk::shuffle(mk::parallel_policy{ 4, 16 }, flags.begin(), flags.end(), rng);
+        CHECK(std::count(flags.begin(), flags.end(), true) == 334);
+
+        auto particles = mk::soa_span(gsl::span(xs), gsl::span(ys));
+        mk::shuffle(mk::parallel_policy{ 4, 16 }, particles.begin(), particles.end(), rng);
+        CHECK(mk::range_all_of([](int x, int y) { return x == -y; }, xs, ys));
+        auto expectedXs = std::vector<int>(1000);
+        std::iota(expectedXs.begin(), expectedXs.end(), 0);
+        CHECK(xs != expectedXs);
+        std::sort(xs.begin(), xs.end());
+        CHECK(xs == expectedXs);
+    }
+}
 
 
 } // anonymous namespace
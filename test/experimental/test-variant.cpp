@@ -1,6 +1,12 @@
 
+#include <makeshift/functional.hpp>  // for overload<>
 #include <makeshift/experimental/variant.hpp>
 
+#include <string>
+#include <vector>
+#include <variant>
+#include <type_traits>  // for is_same<>
+
 #include <gsl-lite/gsl-lite.hpp>
 
 #include <catch2/catch_test_macros.hpp>
@@ -12,7 +18,87 @@ namespace mk = ::makeshift;
 namespace gsl = ::gsl_lite;
 
 
-// TODO: add tests
+struct Circle { double r; };
+struct Rectangle { double w; double h; };
+
+
+TEST_CASE("variant_collection<>")
+{
+    auto shapes = mk::variant_collection<Circle, Rectangle>{ };
+    CHECK(shapes.empty());
+    shapes.push_back(Circle{ 1. });
+    shapes.push_back(Rectangle{ 2., 3. });
+    shapes.push_back(std::variant<Circle, Rectangle>{ Circle{ 2. } });
+    shapes.emplace_back<Rectangle>(1., 1.);
+    shapes.push_back(std::variant<Rectangle>{ Rectangle{ 4., 5. } });
+    CHECK(shapes.size() == 5);
+    REQUIRE(shapes.segment<Circle>().size() == 2);
+    REQUIRE(shapes.segment<Rectangle>().size() == 3);
+    CHECK(shapes.segment<Circle>()[1].r == 2.);
+    CHECK(shapes.segment<Rectangle>()[2].w == 4.);
+
+    SECTION("for_each()")
+    {
+        auto visited = std::string{ };
+        double sum = 0.;
+        shapes.for_each(mk::overload{
+            [&](Circle const& c) { visited += 'c'; sum += c.r; },
+            [&](Rectangle const& r) { visited += 'r'; sum += r.w*r.h; }
+        });
+        CHECK(visited == "ccrrr");
+        CHECK(sum == 1. + 2. + 6. + 1. + 20.);
+
+        shapes.for_each([](auto& shape) { if constexpr (std::is_same_v<std::remove_cvref_t<decltype(shape)>, Circle>) shape.r *= 2.; });
+        CHECK(shapes.segment<Circle>()[0].r == 2.);
+    }
+    SECTION("variant_collection_transform()")
+    {
+        auto areas = mk::variant_collection_transform(
+            mk::overload{
+                [](Circle const& c) { return int(c.r); },
+                [](Rectangle const& r) { return r.w*r.h; }
+            },
+            shapes);
+        static_assert(std::is_same_v<decltype(areas), mk::variant_collection<int, double>>);
+        CHECK(areas.segment<int>().size() == 2);
+        CHECK(areas.segment<double>().size() == 3);
+        CHECK(areas.segment<double>()[0] == 6.);
+
+        auto circlesOnly = mk::variant_collection_transform(
+            mk::overload{
+                [](Circle const& c) { return c; },
+                [](Rectangle const&) { }
+            },
+            shapes);
+        static_assert(std::is_same_v<decltype(circlesOnly), mk::variant_collection<Circle>>);
+        CHECK(circlesOnly.size() == 2);
+
+            // Both alternatives map to `double`, so storage is reserved for the elements of both segments.
+        auto area = mk::overload{
+            [](Circle const& c) { return 3.*c.r*c.r; },
+            [](Rectangle const& r) { return r.w*r.h; }
+        };
+        CHECK(mk::detail::count_transform_results<double, decltype(area)>(shapes) == 5);
+        auto allAreas = mk::variant_collection_transform(area, shapes);
+        static_assert(std::is_same_v<decltype(allAreas), mk::variant_collection<double>>);
+        REQUIRE(allAreas.size() == 5);
+        CHECK(allAreas.segment<double>()[0] == 3.);
+        CHECK(allAreas.segment<double>()[4] == 20.);
+    }
+    SECTION("variant_collection_transform_many()")
+    {
+        auto squaresAndOthers = mk::variant_collection_transform_many(
+            mk::overload{
+                [](Circle const& c) -> std::variant<Circle> { return c; },
+                [](Rectangle const& r) -> std::variant<Circle, Rectangle> { if (r.w == r.h) return Circle{ r.w/2 }; return r; }
+            },
+            shapes);
+        static_assert(std::is_same_v<decltype(squaresAndOthers), mk::variant_collection<Circle, Rectangle>>);
+        CHECK(squaresAndOthers.segment<Circle>().size() == 3);
+        CHECK(squaresAndOthers.segment<Circle>()[2].r == 0.5);
+        CHECK(squaresAndOthers.segment<Rectangle>().size() == 2);
+    }
+}
 
 
 } // anonymous namespace
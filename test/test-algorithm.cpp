@@ -1,11 +1,22 @@
 
+#include <map>
 #include <list>
+#include <deque>
 #include <tuple>
 #include <array>
+#include <string>
+#include <forward_list>
 #include <vector>
+#include <utility>     // for as_const()
+#include <random>
+#include <cstdint>     // for int32_t
+#include <numeric>     // for iota()
+#include <algorithm>   // for sort(), count()
+#include <functional>  // for plus<>
 #include <iterator>
 
 #include <makeshift/algorithm.hpp>
+#include <makeshift/constval.hpp>
 
 #include <iterator>
 
@@ -33,6 +44,63 @@ static_assert(!std::is_base_of<std::input_iterator_tag, makeshift::detail::commo
 static_assert(!std::is_base_of<std::output_iterator_tag, makeshift::detail::common_iterator_tag<std::input_iterator_tag, std::output_iterator_tag>>::value, "static assertion failed");
 
 
+TEST_CASE("shuffle()")
+{
+    SECTION("result is a permutation")
+    {
+        auto rng64 = std::mt19937_64{ 42 };
+        auto rng32 = std::mt19937{ 42 };
+        auto rng31 = std::minstd_rand{ 42 };
+        for (gsl::dim n : { 0, 1, 2, 3, 10, 1001 })
+        {
+            auto v = std::vector<int>(n);
+            std::iota(v.begin(), v.end(), 0);
+            auto v64 = v;
+            mk::shuffle(v64.begin(), v64.end(), rng64);
+            auto v32 = v;
+            mk::shuffle(v32.begin(), v32.end(), rng32);
+            auto v31 = v;
+            mk::shuffle(v31.begin(), v31.end(), rng31);
+            std::sort(v64.begin(), v64.end());
+            std::sort(v32.begin(), v32.end());
+            std::sort(v31.begin(), v31.end());
+            CHECK(v64 == v);
+            CHECK(v32 == v);
+            CHECK(v31 == v);
+        }
+    }
+    SECTION("permutations are uniformly distributed")
+    {
+        auto rng = std::mt19937_64{ 42 };
+        auto counts = std::map<std::array<int, 4>, int>{ };
+        constexpr int numTrials = 48000;
+        for (int i = 0; i != numTrials; ++i)
+        {
+            auto v = std::array{ 0, 1, 2, 3 };
+            mk::shuffle(v.begin(), v.end(), rng);
+            ++counts[v];
+        }
+        CHECK(counts.size() == 24);
+        for (auto const& [perm, count] : counts)
+        {
+            (void) perm;
+            CHECK(count > numTrials/24*9/10);
+            CHECK(count < numTrials/24*11/10);
+        }
+    }
+    SECTION("proxy iterators")
+    {
+        auto rng = std::mt19937{ 42 };
+        auto v = std::vector<bool>(100);
+        for (gsl::index i = 0; i < 100; i += 3)
+        {
+            v[i] = true;
+        }
+        mk::shuffle(v.begin(), v.end(), rng);
+        CHECK(std::count(v.begin(), v.end(), true) == 34);
+    }
+}
+
 TEST_CASE("range_zip()")
 {
     auto vec0 = std::vector<int>{ };
@@ -147,6 +215,492 @@ TEST_CASE("range_for()")
     }
 }
 
+TEST_CASE("range_for_unrolled()")
+{
+    auto vec7 = std::vector<int>{ 1, 2, 3, 4, 5, 6, 7 };
+    auto arr7 = std::array<int, 7>{ 11, 12, 13, 14, 15, 16, 17 };
+
+    SECTION("basic use with index")
+    {
+        auto visited = std::vector<gsl::index>{ };
+        mk::range_for_unrolled(
+            std::integral_constant<int, 3>{ },
+            [&](gsl::index iv, int& vv, int av)
+            {
+                CHECK(vv == iv + 1);
+                CHECK(av == iv + 11);
+                vv = -vv;
+                visited.push_back(iv);
+            },
+            mk::range_index, vec7, arr7);
+        CHECK(visited == std::vector<gsl::index>{ 0, 1, 2, 3, 4, 5, 6 });
+        CHECK(vec7 == std::vector<int>{ -1, -2, -3, -4, -5, -6, -7 });
+    }
+    SECTION("lane index")
+    {
+        auto partialSums = std::array<int, 4>{ };
+        mk::range_for_unrolled(
+            std::integral_constant<int, 4>{ },
+            [&](auto laneC, gsl::index iv, int v)
+            {
+                static_assert(decltype(laneC)::value < 4, "static assertion failed");
+                CHECK(laneC() == iv % 4);
+                partialSums[laneC] += v;
+            },
+            mk::range_index, vec7);
+        CHECK(partialSums == std::array<int, 4>{ 1 + 5, 2 + 6, 3 + 7, 4 });
+    }
+    SECTION("no remainder")
+    {
+        int n = 0;
+        mk::range_for_unrolled(std::integral_constant<int, 1>{ }, [&](int) { ++n; }, arr7);
+        CHECK(n == 7);
+        n = 0;
+        mk::range_for_unrolled(std::integral_constant<int, 7>{ }, [&](int) { ++n; }, arr7);
+        CHECK(n == 7);
+    }
+}
+
+TEST_CASE("range_transform()")
+{
+    auto arr3 = std::array<int, 3>{ 21, 22, 23 };
+    auto vec3 = std::vector<int>{ 1, 2, 3 };
+    auto list3 = std::list<int>{ 11, 12, 13 };
+
+    SECTION("basic use")
+    {
+        auto sums = mk::range_transform([](int lhs, int rhs) { return lhs + rhs; }, vec3, list3);
+        CHECK(sums.size() == 3);
+        int i = 0;
+        for (int sum : sums)
+        {
+            CHECK(sum == 2*i + 12);
+            ++i;
+        }
+        CHECK(i == 3);
+    }
+    SECTION("static size is retained")
+    {
+        auto squares = mk::range_transform([](int x) { return x*x; }, arr3);
+        static_assert(decltype(mk::detail::range_size(squares))::value == 3, "static assertion failed");
+        CHECK(squares[1] == 22*22);
+    }
+    SECTION("fused with range_zip()")
+    {
+        auto i_s = mk::range_zip(mk::range_index, mk::range_transform([](int lhs, int rhs) { return lhs*rhs; }, arr3, vec3));
+        int i = 0;
+        for (auto&& [iv, pv] : i_s)
+        {
+            CHECK(iv == i);
+            CHECK(pv == (21 + i)*(1 + i));
+            ++i;
+        }
+        CHECK(i == 3);
+    }
+    SECTION("fused with range_for()")
+    {
+        auto doubled = mk::range_transform([](int x) { return 2*x; }, list3);
+        int i = 0;
+        mk::range_for(
+            [&](gsl::index iv, int dv, int& vv)
+            {
+                CHECK(iv == i);
+                CHECK(dv == 2*(i + 11));
+                vv = dv;
+                ++i;
+            },
+            mk::range_index, doubled, vec3);
+        CHECK(i == 3);
+        CHECK(vec3 == std::vector<int>{ 22, 24, 26 });
+    }
+    SECTION("references are passed through")
+    {
+        mk::range_for(
+            [](int& x) { x = -x; },
+            mk::range_transform([](int& x) -> int& { return x; }, vec3));
+        CHECK(vec3 == std::vector<int>{ -1, -2, -3 });
+    }
+    SECTION("ranges of unknown size")
+    {
+        auto flist = std::forward_list<int>{ 1, 2, 3 };
+        auto doubled = mk::range_transform([](int x) { return 2*x; }, flist);
+        static_assert(std::is_same<decltype(mk::detail::range_size(doubled)), mk::detail::dim_constant<mk::detail::unknown_size>>::value, "static assertion failed");
+        int i = 0;
+        for (int x : doubled)
+        {
+            CHECK(x == 2*(i + 1));
+            ++i;
+        }
+        CHECK(i == 3);
+
+        int sum = 0;
+        mk::range_for([&sum](int x) { sum += x; }, mk::range_transform([](int x, int y) { return x*y; }, flist, flist));
+        CHECK(sum == 1 + 4 + 9);
+        mk::range_for(
+            [](int x, int v) { CHECK(x == 2*v); },
+            doubled, vec3);
+    }
+    SECTION("constness of ranges held by value is propagated")
+    {
+        auto identity = [](auto& x) -> auto& { return x; };
+        auto owning = mk::range_transform(identity, std::vector<int>{ 1, 2, 3 });
+        static_assert(std::is_same<decltype(owning[0]), int&>::value, "static assertion failed");
+        static_assert(std::is_same<decltype(std::as_const(owning)[0]), int const&>::value, "static assertion failed");
+        auto referencing = mk::range_transform(identity, vec3);
+        static_assert(std::is_same<decltype(std::as_const(referencing)[0]), int&>::value, "static assertion failed");
+
+        auto const zipped = mk::range_zip(mk::range_index, mk::range_transform(identity, std::vector<int>{ 1, 2, 3 }));
+        static_assert(std::is_same<std::tuple_element_t<1, decltype(zipped[0])>, int const&>::value, "static assertion failed");
+        CHECK(std::get<1>(zipped[2]) == 3);
+    }
+    SECTION("nested transformation")
+    {
+        auto result = mk::range_transform_reduce(0, std::plus<>{ }, [](int x) { return x; },
+            mk::range_transform([](int x) { return x + 1; },
+                mk::range_transform([](gsl::index i, int x) { return int(i)*x; }, mk::range_index, vec3)));
+        CHECK(result == 0*1 + 1*2 + 2*3 + 3);
+    }
+    SECTION("error when trying to combine ranges with different sizes")
+    {
+        auto vec4 = std::vector<int>{ 1, 2, 3, 4 };
+        CHECK_THROWS(mk::range_transform([](int, int) { return 0; }, vec3, vec4));
+    }
+}
+
+TEST_CASE("indirect_range()")
+{
+    auto values = std::vector<int>{ 10, 20, 30, 40, 50 };
+    auto indices = std::array<gsl::index, 3>{ 4, 0, 2 };
+
+    SECTION("gather")
+    {
+        auto gathered = mk::indirect_range(indices, values);
+        CHECK(gathered.size() == 3);
+        static_assert(decltype(mk::detail::range_size(gathered))::value == 3, "static assertion failed");
+        int i = 0;
+        for (int v : gathered)
+        {
+            CHECK(v == values[indices[i]]);
+            ++i;
+        }
+        CHECK(i == 3);
+        CHECK(gathered[1] == 10);
+    }
+    SECTION("scatter")
+    {
+        mk::range_for(
+            [](gsl::index i, int& v) { v = -int(i); },
+            mk::range_index, mk::indirect_range(indices, values));
+        CHECK(values == std::vector<int>{ -1, 20, -2, 40, 0 });
+    }
+    SECTION("with prefetching")
+    {
+        auto idx = std::vector<gsl::index>(100);
+        std::iota(idx.rbegin(), idx.rend(), gsl::index(0));
+        auto data = std::vector<int>(100);
+        std::iota(data.begin(), data.end(), 0);
+        auto sum = mk::range_transform_reduce(0, std::plus<>{ }, [](gsl::index i, int v) { return int(i)*v; },
+            mk::range_index, mk::indirect_range(idx, data, std::integral_constant<std::ptrdiff_t, 8>{ }));
+        int expectedSum = 0;
+        for (int i = 0; i != 100; ++i)
+        {
+            expectedSum += i*(99 - i);
+        }
+        CHECK(sum == expectedSum);
+    }
+    SECTION("non-contiguous data range")
+    {
+        auto deque = std::deque<int>{ 1, 2, 3, 4, 5 };
+        auto zipped = mk::range_zip(mk::range_index, mk::indirect_range(indices, deque));
+        CHECK(std::get<1>(zipped[0]) == 5);
+        CHECK(std::get<1>(zipped[1]) == 1);
+        CHECK(std::get<1>(zipped[2]) == 3);
+    }
+    SECTION("index range of unknown size")
+    {
+        auto flist = std::forward_list<gsl::index>{ 3, 1 };
+        auto gathered = mk::indirect_range(flist, values);
+        static_assert(!mk::detail::has_size<decltype(gathered)>::value, "static assertion failed");
+        int sum = 0;
+        mk::range_for([&](int v) { sum += v; }, gathered);
+        CHECK(sum == 60);
+    }
+    SECTION("error when trying to combine ranges with different sizes")
+    {
+        CHECK_THROWS(mk::range_zip(mk::indirect_range(indices, values), values));
+    }
+    SECTION("error when an index is out of range")
+    {
+        auto fourElements = std::vector<int>{ 1, 2, 3, 4 };
+        CHECK_THROWS(mk::range_for([](int) { }, mk::indirect_range(std::vector{ 3, 7 }, fourElements)));
+        CHECK_THROWS(mk::range_for([](int) { }, mk::indirect_range(std::vector{ -1 }, fourElements)));
+        CHECK_THROWS(mk::indirect_range(std::array{ 4 }, fourElements)[0]);
+    }
+}
+
+TEST_CASE("strided_range()")
+{
+        // 3×4 row-major matrix
+    auto matrix = std::vector<int>{
+        0,  1,  2,  3,
+        10, 11, 12, 13,
+        20, 21, 22, 23 };
+
+    SECTION("column of a row-major matrix")
+    {
+        auto column = mk::strided_range(matrix.data() + 2, 3, 4);
+        CHECK(column.size() == 3);
+        CHECK(column.stride() == 4);
+        CHECK(column[1] == 12);
+        int i = 0;
+        for (int v : column)
+        {
+            CHECK(v == 10*i + 2);
+            ++i;
+        }
+        CHECK(i == 3);
+    }
+    SECTION("constval size and stride")
+    {
+        auto row = mk::strided_range(matrix.data() + 4, mk::dim_c<4>, mk::stride_c<1>);
+        static_assert(decltype(mk::detail::range_size(row))::value == 4, "static assertion failed");
+        static_assert(std::is_same<decltype(row._stride()), mk::stride_constant<1>>::value, "static assertion failed");
+        mk::range_for(
+            [](gsl::index i, int& v) { v = -int(i); },
+            mk::range_index, row);
+        CHECK(matrix == std::vector<int>{ 0, 1, 2, 3, 0, -1, -2, -3, 20, 21, 22, 23 });
+    }
+    SECTION("field of an array of structures")
+    {
+        struct Point { double x, y, z; };
+        auto points = std::vector<Point>{ { 1, 2, 3 }, { 4, 5, 6 } };
+        auto ys = mk::strided_range(points.data(), &Point::y, gsl::ssize(points));
+        CHECK(ys.size() == 2);
+        CHECK(ys[1] == 5);
+        auto sum = mk::range_transform_reduce(0., std::plus<>{ }, [](double y, double z) { return y*z; },
+            ys, mk::strided_range(std::as_const(points).data(), &Point::z, mk::dim_c<2>));
+        CHECK(sum == 2*3 + 5*6);
+        static_assert(std::is_same<decltype(mk::strided_range(std::as_const(points).data(), &Point::z, 2)[0]), double const&>::value, "static assertion failed");
+
+        mk::range_for(
+            [](double& x, double y) { x = -y; },
+            mk::strided_range(points.data(), &Point::x, gsl::ssize(points)), ys.last(2));
+        CHECK(points[0].x == -2);
+        CHECK(points[1].x == -5);
+        CHECK(points[1].z == 6);
+    }
+    SECTION("subspan")
+    {
+        auto column = mk::strided_range(matrix.data() + 1, 3, 4);
+        auto tail = column.subspan(1);
+        CHECK(tail.size() == 2);
+        CHECK(tail[0] == 11);
+        CHECK(tail[1] == 21);
+        CHECK(column.first(1)[0] == 1);
+        CHECK(column.last(1)[0] == 21);
+        CHECK_THROWS(column.subspan(2, 2));
+    }
+    SECTION("error when trying to combine ranges with different sizes")
+    {
+        CHECK_THROWS(mk::range_zip(mk::strided_range(matrix.data(), 3, 4), matrix));
+    }
+}
+
+constexpr std::array<int, 4>
+iota4(int value)
+{
+    auto result = std::array<int, 4>{ };
+    mk::range_iota(result, value);
+    return result;
+}
+static_assert(iota4(3) == std::array<int, 4>{ 3, 4, 5, 6 }, "static assertion failed");
+
+TEST_CASE("range_fill(), range_iota(), range_generate()")
+{
+    SECTION("small ranges")
+    {
+        auto vec = std::vector<int>(5);
+        mk::range_fill(vec, 3);
+        CHECK(vec == std::vector<int>{ 3, 3, 3, 3, 3 });
+        mk::range_iota(vec, 1);
+        CHECK(vec == std::vector<int>{ 1, 2, 3, 4, 5 });
+        int i = 0;
+        mk::range_generate(vec, [&i] { return i *= 2, ++i; });
+        CHECK(vec == std::vector<int>{ 1, 3, 7, 15, 31 });
+    }
+    SECTION("non-contiguous ranges")
+    {
+        auto list = std::list<double>(3);
+        mk::range_iota(list, 0.5);
+        CHECK(list == std::list<double>{ 0.5, 1.5, 2.5 });
+    }
+    SECTION("large ranges")
+    {
+            // Larger than the threshold for non-temporal stores; the subspan is not aligned to a cache line.
+        auto vec = std::vector<std::int32_t>((std::size_t(1) << 20) + 100);
+        auto span = gsl::span<std::int32_t>(vec).subspan(3, vec.size() - 8);
+        mk::range_iota(span, std::int32_t(1));
+        CHECK(vec[2] == 0);
+        for (gsl::index i = 0; i != gsl::ssize(span); ++i)
+        {
+            if (span[i] != i + 1) FAIL("span[" << i << "] == " << span[i]);
+        }
+        CHECK(vec[vec.size() - 5] == 0);
+        mk::range_fill(span, 7);
+        CHECK(std::count(vec.begin(), vec.end(), 7) == gsl::ssize(span));
+        std::int32_t j = 0;
+        mk::range_generate(span, [&j] { return j++; });
+        CHECK(span[gsl::ssize(span) - 1] == gsl::ssize(span) - 1);
+    }
+}
+
+TEST_CASE("range_find_if()")
+{
+    auto vec = std::vector<int>{ 1, -2, 3, -4 };
+    auto list = std::list<int>{ 1, 2, 3, 4 };
+
+    CHECK(mk::range_find_if([](int x) { return x < 0; }, vec) == 1);
+    CHECK(mk::range_find_if([](int x) { return x > 4; }, vec) == -1);
+    CHECK(mk::range_find_if([](int x, int y) { return x*y == -16; }, vec, list) == 3);
+    CHECK(mk::range_find_if([](gsl::index i, int x) { return i > 1 && x > 0; }, mk::range_index, vec) == 2);
+    CHECK(mk::range_find_if([](int) { return true; }, std::vector<int>{ }) == -1);
+
+    auto flist = std::forward_list<int>{ 1, -2, 3 };
+    CHECK(mk::range_find_if([](int x) { return x > 1; }, flist) == 2);
+    CHECK(mk::range_find_if([](int x) { return x > 4; }, flist) == -1);
+}
+
+TEST_CASE("range_inclusive_scan()")
+{
+    auto vec3 = std::vector<int>{ 1, 2, 3 };
+    auto list3 = std::list<int>{ 11, 12, 13 };
+
+    SECTION("basic use")
+    {
+        auto out = std::vector<int>(3);
+        int total = mk::range_inclusive_scan(0, std::plus<>{ }, [](int x) { return x; }, out, vec3);
+        CHECK(total == 6);
+        CHECK(out == std::vector<int>{ 1, 3, 6 });
+    }
+    SECTION("multiple ranges")
+    {
+        auto out = std::vector<int>(3);
+        int total = mk::range_inclusive_scan(100, std::plus<>{ }, [](gsl::index i, int v, int l) { return int(i)*(v + l); }, out, mk::range_index, vec3, list3);
+        CHECK(total == 100 + 14 + 2*16);
+        CHECK(out == std::vector<int>{ 100, 114, 146 });
+    }
+    SECTION("in-place")
+    {
+        mk::range_inclusive_scan(0, std::plus<>{ }, [](int x) { return x; }, vec3, vec3);
+        CHECK(vec3 == std::vector<int>{ 1, 3, 6 });
+    }
+    SECTION("error when trying to combine ranges with different sizes")
+    {
+        auto out = std::vector<int>(4);
+        CHECK_THROWS(mk::range_inclusive_scan(0, std::plus<>{ }, [](int x) { return x; }, out, vec3));
+    }
+}
+
+TEST_CASE("range_exclusive_scan()")
+{
+    auto vec3 = std::vector<int>{ 1, 2, 3 };
+
+    SECTION("basic use")
+    {
+        auto out = std::array<int, 3>{ };
+        int total = mk::range_exclusive_scan(0, std::plus<>{ }, [](int x) { return x; }, out, vec3);
+        CHECK(total == 6);
+        CHECK(out == std::array<int, 3>{ 0, 1, 3 });
+    }
+    SECTION("in-place")
+    {
+        int total = mk::range_exclusive_scan(0, std::plus<>{ }, [](int x) { return x; }, vec3, vec3);
+        CHECK(total == 6);
+        CHECK(vec3 == std::vector<int>{ 0, 1, 3 });
+    }
+}
+
+TEST_CASE("range_copy_if()")
+{
+    auto vec5 = std::vector<int>{ 1, -2, 3, -4, 5 };
+
+    SECTION("basic use")
+    {
+        auto out = std::vector<int>(5, 0);
+        auto n = mk::range_copy_if([](int x) { return x > 0; }, out, vec5);
+        CHECK(n == 3);
+        CHECK(std::vector<int>(out.begin(), out.begin() + n) == std::vector<int>{ 1, 3, 5 });
+    }
+    SECTION("output range smaller than input range")
+    {
+        auto out = std::array<int, 3>{ };
+        auto n = mk::range_copy_if([](int x) { return x > 0; }, out, vec5);
+        CHECK(n == 3);
+        CHECK(out == std::array<int, 3>{ 1, 3, 5 });
+    }
+    SECTION("zipped ranges")
+    {
+        auto indices = std::vector<gsl::index>(5);
+        auto values = std::list<int>(5);
+        auto n = mk::range_copy_if(
+            [](gsl::index, int v) { return v < 0; },
+            mk::range_zip(indices, values),
+            mk::range_index, vec5);
+        CHECK(n == 2);
+        CHECK(indices[0] == 1);
+        CHECK(indices[1] == 3);
+        CHECK(*values.begin() == -2);
+        CHECK(*std::next(values.begin()) == -4);
+    }
+    SECTION("error when output range is too small")
+    {
+        auto out = std::array<int, 2>{ };
+        CHECK_THROWS(mk::range_copy_if([](int x) { return x > 0; }, out, vec5));
+    }
+    SECTION("input range of unknown size")
+    {
+        auto flist5 = std::forward_list<int>{ 1, -2, 3, -4, 5 };
+        auto out = std::vector<int>(5, 0);
+        auto n = mk::range_copy_if([](int x) { return x > 0; }, out, flist5);
+        CHECK(n == 3);
+        CHECK(out == std::vector<int>{ 1, 3, 5, 0, 0 });
+    }
+}
+
+TEST_CASE("range_remove_if()")
+{
+    auto vec5 = std::vector<int>{ 1, -2, 3, -4, 5 };
+    auto list5 = std::list<int>{ 11, 12, 13, 14, 15 };
+
+    SECTION("branchless")
+    {
+        auto vec5b = std::vector<double>{ 1., 2., 3., 4., 5. };
+        auto n = mk::range_remove_if([](int x, double) { return x < 0; }, vec5, vec5b);
+        CHECK(n == 3);
+        vec5.resize(n);
+        vec5b.resize(n);
+        CHECK(vec5 == std::vector<int>{ 1, 3, 5 });
+        CHECK(vec5b == std::vector<double>{ 1., 3., 5. });
+    }
+    SECTION("non-trivial element types and bidirectional ranges")
+    {
+        auto strs = std::vector<std::string>{ "a", "b", "c", "d", "e" };
+        auto n = mk::range_remove_if([](gsl::index i, std::string const&, int l) { return i == 0 || l == 14; }, mk::range_index, strs, list5);
+        CHECK(n == 3);
+        strs.resize(n);
+        list5.resize(n);
+        CHECK(strs == std::vector<std::string>{ "b", "c", "e" });
+        CHECK(list5 == std::list<int>{ 12, 13, 15 });
+    }
+    SECTION("ranges of unknown size")
+    {
+        auto flist5 = std::forward_list<int>{ 1, -2, 3, -4, 5 };
+        auto n = mk::range_remove_if([](int x) { return x < 0; }, flist5);
+        CHECK(n == 3);
+        CHECK(std::vector<int>(flist5.begin(), std::next(flist5.begin(), n)) == std::vector<int>{ 1, 3, 5 });
+    }
+}
+
 // TODO: add more tests
 
 
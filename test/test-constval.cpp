@@ -254,6 +254,9 @@ TEST_CASE("constval_range_to_array")
 
     constexpr std::array fibonacciSeqUpTo50 = makeshift::constval_range_to_array([] { return computeFibonacciSeqUpTo(50); });
     CHECK(fibonacciSeqUpTo50 == std::array{ 1, 1, 2, 3, 5, 8, 13, 21, 34 });
+
+    auto fibonacciSeqUpTo20C = makeshift::constval_range_to_array(MAKESHIFT_CONSTVAL(20), [](int max) { return computeFibonacciSeqUpTo(max); });
+    static_assert(std::is_same<decltype(fibonacciSeqUpTo20C), makeshift::array_constant<int, 1, 1, 2, 3, 5, 8, 13>>::value, "wrong type");
 }
 
 
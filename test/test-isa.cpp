@@ -0,0 +1,80 @@
+
+#include <makeshift/isa.hpp>
+
+#include <array>
+#include <bit>        // for popcount()
+#include <string>
+#include <stdexcept>  // for runtime_error
+
+#include <makeshift/string.hpp>  // for enum_to_string()
+
+#include <gsl-lite/gsl-lite.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+
+namespace {
+
+namespace mk = ::makeshift;
+
+
+MAKESHIFT_ISA_TARGET_AVX2 int
+popcount_avx2(unsigned value)
+{
+    return std::popcount(value);
+}
+
+int
+popcount_scalar(unsigned value)
+{
+    int result = 0;
+    for (; value != 0; value &= value - 1)
+    {
+        ++result;
+    }
+    return result;
+}
+
+
+} // anonymous namespace
+
+
+TEST_CASE("isa")
+{
+    SECTION("reflection")
+    {
+        CHECK(mk::enum_to_string(mk::isa::sse4_2) == "sse4.2");
+        CHECK(mk::parse_enum<mk::isa>("avx512") == mk::isa::avx512);
+    }
+    SECTION("override")
+    {
+        CHECK(mk::detail::select_isa(mk::isa::avx2, nullptr) == mk::isa::avx2);
+        CHECK(mk::detail::select_isa(mk::isa::avx2, "") == mk::isa::avx2);
+        CHECK(mk::detail::select_isa(mk::isa::avx2, "sse4.2") == mk::isa::sse4_2);
+        CHECK(mk::detail::select_isa(mk::isa::avx2, "avx512") == mk::isa::avx2);
+        CHECK_THROWS_AS(mk::detail::select_isa(mk::isa::avx2, "avx3"), std::runtime_error);
+    }
+    SECTION("current_isa()")
+    {
+        CHECK(mk::current_isa() == mk::current_isa());
+        CHECK(mk::current_isa() <= mk::detail::detect_isa<mk::isa>());
+    }
+    SECTION("expand_isa()")
+    {
+        mk::isa level = mk::expand_isa([](auto isaC) { return isaC(); });
+        CHECK(level == mk::current_isa());
+
+        unsigned value = 0xF00Fu;
+        int count = mk::expand_isa(
+            [value](auto isaC)
+            {
+                if constexpr (isaC() == mk::isa::avx2) return popcount_avx2(value);
+                else return popcount_scalar(value);
+            },
+            MAKESHIFT_CONSTVAL(std::array{ mk::isa::scalar, mk::isa::avx2 }));
+        CHECK(count == 8);
+
+        mk::isa selected = mk::expand_isa([](auto isaC) { return isaC(); }, MAKESHIFT_CONSTVAL(std::array{ mk::isa::scalar, mk::isa::sse4_2 }));
+        CHECK(selected == (mk::current_isa() >= mk::isa::sse4_2 ? mk::isa::sse4_2 : mk::isa::scalar));
+    }
+}
@@ -0,0 +1,82 @@
+
+#include <makeshift/lut.hpp>
+
+#include <array>
+#include <bit>      // for countr_zero()
+#include <utility>  // for pair<>
+
+#include <makeshift/constval.hpp>  // for MAKESHIFT_CONSTVAL()
+
+#include <gsl-lite/gsl-lite.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+
+namespace {
+
+namespace mk = ::makeshift;
+namespace gsl = ::gsl_lite;
+
+
+enum class Precision { single, double_ };
+constexpr auto
+reflect(gsl::type_identity<Precision>)
+{
+    return std::array{
+        std::pair{ Precision::single, "single" },
+        std::pair{ Precision::double_, "double" }
+    };
+}
+
+constexpr int
+bytes_per_vector(Precision precision, int width)
+{
+    return (precision == Precision::single ? 4 : 8)*width;
+}
+
+constinit auto const bytesPerVector = mk::make_lut(bytes_per_vector,
+    gsl::type_identity<Precision>{ }, MAKESHIFT_CONSTVAL(std::array{ 1, 4, 8, 16 }));
+
+constexpr auto primesBelow20 = mk::make_lut(
+    [](int n)
+    {
+        for (int d = 2; d*d <= n; ++d)
+        {
+            if (n % d == 0) return false;
+        }
+        return n >= 2;
+    },
+    MAKESHIFT_CONSTVAL(std::array{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 }));
+
+
+} // anonymous namespace
+
+
+TEST_CASE("make_lut()")
+{
+    SECTION("one-dimensional")
+    {
+        static_assert(primesBelow20.size == 20, "static assertion failed");
+        CHECK(primesBelow20(7));
+        CHECK_FALSE(primesBelow20(9));
+        CHECK(primesBelow20(19));
+    }
+    SECTION("multi-dimensional")
+    {
+        static_assert(decltype(bytesPerVector)::rank == 2, "static assertion failed");
+        CHECK(bytesPerVector.data() == std::array{ 4, 16, 32, 64, 8, 32, 64, 128 });
+        for (Precision precision : { Precision::single, Precision::double_ })
+        {
+            for (int width : { 1, 4, 8, 16 })
+            {
+                CHECK(bytesPerVector(precision, width) == bytes_per_vector(precision, width));
+            }
+        }
+    }
+    SECTION("sparse domain")
+    {
+        auto log2 = mk::make_lut([](unsigned x) { return std::countr_zero(x); }, MAKESHIFT_CONSTVAL(std::array{ 1u, 2u, 4u, 8u, 16u, 32u, 64u, 128u }));
+        CHECK(log2(64u) == 6);
+        CHECK(log2(1u) == 0);
+    }
+}
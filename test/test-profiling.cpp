@@ -0,0 +1,91 @@
+﻿
+#define MAKESHIFT_DISPATCH_PROFILING 1
+
+#include <makeshift/profiling.hpp>
+
+#include <array>
+#include <string>
+#include <sstream>
+#include <variant>
+#include <utility>      // for pair<>
+
+#include <gsl-lite/gsl-lite.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+
+namespace {
+
+namespace mk = ::makeshift;
+namespace gsl = ::gsl_lite;
+
+
+enum class Shade { light, medium, dark };
+constexpr auto
+reflect(gsl::type_identity<Shade>)
+{
+    return std::array{
+        std::pair{ Shade::light, "light" },
+        std::pair{ Shade::medium, "medium" },
+        std::pair{ Shade::dark, "dark" }
+    };
+}
+
+std::string
+dispatch_profile_string(void)
+{
+    auto stream = std::ostringstream{ };
+    mk::print_dispatch_profile(stream);
+    return stream.str();
+}
+
+bool
+contains(std::string const& str, std::string const& substr)
+{
+    return str.find(substr) != std::string::npos;
+}
+
+struct bits_site;
+struct shade_site;
+
+
+} // anonymous namespace
+
+
+TEST_CASE("dispatch profiling")
+{
+    mk::reset_dispatch_profile();
+
+    SECTION("expand() with explicit values")
+    {
+        for (int bits : { 16, 64, 64, 64 })
+        {
+            auto bitsV = mk::expand(bits, MAKESHIFT_CONSTVAL(std::array{ 16, 32, 64 }), mk::dispatch_profiler<bits_site>{ });
+            CHECK(std::visit([](auto bitsC) { return bitsC(); }, bitsV) == bits);
+        }
+        CHECK_THROWS_AS(mk::expand(42, MAKESHIFT_CONSTVAL(std::array{ 16, 32, 64 }), mk::dispatch_profiler<bits_site>{ }), mk::unsupported_runtime_value);
+
+        auto profile = dispatch_profile_string();
+        CHECK(contains(profile, "expand()"));
+        CHECK(contains(profile, "    16: 1\n    32: 0\n    64: 3\n    (unsupported): 1\n"));
+    }
+    SECTION("try_expand() and expand_failfast() with reflected values")
+    {
+        auto shadeVO = mk::try_expand(Shade(42), mk::dispatch_profiler<shade_site>{ });
+        CHECK_FALSE(shadeVO.has_value());
+        auto shadeV = mk::expand_failfast(Shade::dark, MAKESHIFT_DISPATCH_SITE());
+        CHECK(std::visit([](auto shadeC) { return shadeC(); }, shadeV) == Shade::dark);
+
+        auto profile = dispatch_profile_string();
+        CHECK(contains(profile, "try_expand()"));
+        CHECK(contains(profile, "expand_failfast()"));
+        CHECK(contains(profile, "    light: 0\n    medium: 0\n    dark: 0\n    (unsupported): 1\n"));
+        CHECK(contains(profile, "    light: 0\n    medium: 0\n    dark: 1\n"));
+    }
+    SECTION("disabled profiler")
+    {
+        auto loggingV = mk::expand(true, mk::no_dispatch_profiler{ });
+        CHECK(std::visit([](auto loggingC) { return loggingC(); }, loggingV));
+        CHECK_FALSE(contains(dispatch_profile_string(), "false"));
+    }
+}
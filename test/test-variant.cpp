@@ -1,8 +1,16 @@
 
+#include <makeshift/tuple.hpp>    // for value_tuple<>
 #include <makeshift/variant.hpp>
 #include <makeshift/experimental/variant.hpp>
 
+#include <span>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <limits>
+#include <cstdint>      // for uint64_t
 #include <variant>
+#include <utility>      // for pair<>, as_const()
 #include <type_traits>  // for is_same<>
 
 #include <gsl-lite/gsl-lite.hpp>
@@ -44,6 +52,76 @@ struct NestedVarTransformer
     V1 operator ()(int i, char const*) const { return i; }
 };
 
+struct DerivedV1 : V1
+{
+    using V1::V1;
+};
+
+struct Visitor
+{
+    int operator ()(int i, char const*) const { return i; }
+    int operator ()(int i, int j) const { return i + j; }
+    int operator ()(float f, char const*) const { return int(f) + 100; }
+    int operator ()(float f, int j) const { return int(f) + j + 100; }
+};
+
+TEST_CASE("visit()")
+{
+    auto v1 = GENERATE(V1{ 1 }, V1{ 2.f });
+    auto v2 = GENERATE(V2{ "foo" }, V2{ 3 });
+    int expected = std::visit(Visitor{ }, v1, v2);
+
+    SECTION("automatic dispatch")
+    {
+        CHECK(mk::visit(Visitor{ }, v1, v2) == expected);
+    }
+    SECTION("jump table")
+    {
+        CHECK(mk::visit<mk::visit_dispatch::jump_table>(Visitor{ }, v1, v2) == expected);
+    }
+    SECTION("switch statement")
+    {
+        CHECK(mk::visit<mk::visit_dispatch::switch_statement>(Visitor{ }, v1, v2) == expected);
+    }
+    SECTION("explicit result type")
+    {
+        CHECK(mk::visit<long>(Visitor{ }, v1, v2) == expected);
+        CHECK(mk::visit<long, mk::visit_dispatch::jump_table>(Visitor{ }, v1, v2) == expected);
+        int calls = 0;
+        mk::visit<void>([&calls](auto const&...) { ++calls; return 42; }, v1, v2);
+        CHECK(calls == 1);
+    }
+    SECTION("arguments are forwarded")
+    {
+        auto v = V1{ 4 };
+        mk::visit([](auto& x) { x *= 2; }, v);
+        CHECK(std::get<int>(v) == 8);
+        CHECK(mk::visit([](auto&& x) { return std::is_rvalue_reference<decltype(x)>::value; }, V1{ 1 }));
+    }
+    SECTION("many combinations")
+    {
+            // 5·5·3 = 75 combinations, more than a single `switch` statement can handle
+        using V5 = std::variant<char, short, int, long, long long>;
+        using V3b = std::variant<float, double, long double>;
+        auto a = V5{ 3L };
+        auto b = V5{ short(5) };
+        auto c = V3b{ 2. };
+        auto func = [](auto x, auto y, auto z) { return double(x)*double(y) + double(z) + sizeof(x)*1000; };
+        double expectedResult = std::visit(func, a, b, c);
+        CHECK(mk::visit<mk::visit_dispatch::switch_statement>(func, a, b, c) == expectedResult);
+        CHECK(mk::visit<mk::visit_dispatch::jump_table>(func, a, b, c) == expectedResult);
+    }
+    SECTION("types derived from std::variant<>")
+    {
+        auto dv1 = DerivedV1{ 3.5f };
+        CHECK(mk::visit([](auto x) { return double(x); }, dv1) == 3.5);
+        CHECK(mk::visit(Visitor{ }, DerivedV1{ 1 }, v2) == std::visit(Visitor{ }, DerivedV1{ 1 }, v2));
+        CHECK(mk::visit<mk::visit_dispatch::switch_statement>(Visitor{ }, std::as_const(dv1), v2) == std::visit(Visitor{ }, dv1, v2));
+    }
+}
+
+static_assert(mk::visit([](auto x) { return int(x) + 1; }, std::variant<int, char>{ 'a' }) == 'b');
+
 TEST_CASE("variant_transform()")
 {
     using VT12 = std::variant<int, char const*>;
@@ -82,5 +160,328 @@ TEST_CASE("expand()")
     CHECK(res == str);
 }
 
+struct Precision
+{
+    int bits;
+    bool fast;
+
+    friend constexpr bool operator ==(Precision const&, Precision const&) = default;
+};
+constexpr auto
+reflect(gsl::type_identity<Precision>)
+{
+    return mk::value_tuple{ &Precision::bits, &Precision::fast };
+}
+
+constexpr std::size_t numManyValues = 1000;
+
+constexpr std::array<double, numManyValues>
+make_many_values(void)
+{
+        // distinct and unordered, since squares modulo a prime are distinct for all integers below half of it
+    auto result = std::array<double, numManyValues>{ };
+    for (std::size_t i = 0; i != numManyValues; ++i)
+    {
+        result[i] = double(i*i % 7919) + 0.5;
+    }
+    return result;
+}
+
+template <typename T, typename ValuesC>
+std::ptrdiff_t
+expanded_index(T const& value, ValuesC valuesC)
+{
+    auto valueVO = mk::try_expand(value, valuesC);
+    return valueVO.has_value() ? std::ptrdiff_t(valueVO->index()) : -1;
+}
+
+TEST_CASE("try_expand() with different value search strategies")
+{
+    using namespace std::literals;
+    using mk::detail::value_search_strategy;
+
+    SECTION("arithmetic progression")
+    {
+        constexpr auto valuesC = MAKESHIFT_CONSTVAL(std::array{ 10, 20, 30, 40, 50 });
+        static_assert(mk::detail::select_integral_value_search_strategy(mk::detail::to_search_keys<int>(valuesC.value)) == value_search_strategy::arithmetic);
+        CHECK(expanded_index(10, valuesC) == 0);
+        CHECK(expanded_index(30, valuesC) == 2);
+        CHECK(expanded_index(50, valuesC) == 4);
+        CHECK(expanded_index(35, valuesC) == -1);
+        CHECK(expanded_index(0, valuesC) == -1);
+        CHECK(expanded_index(60, valuesC) == -1);
+        CHECK(expanded_index(-10, valuesC) == -1);
+    }
+    SECTION("decreasing arithmetic progression")
+    {
+        constexpr auto valuesC = MAKESHIFT_CONSTVAL(std::array{ 9, 6, 3, 0, -3 });
+        static_assert(mk::detail::select_integral_value_search_strategy(mk::detail::to_search_keys<int>(valuesC.value)) == value_search_strategy::arithmetic);
+        CHECK(expanded_index(9, valuesC) == 0);
+        CHECK(expanded_index(3, valuesC) == 2);
+        CHECK(expanded_index(-3, valuesC) == 4);
+        CHECK(expanded_index(4, valuesC) == -1);
+        CHECK(expanded_index(12, valuesC) == -1);
+        CHECK(expanded_index(-6, valuesC) == -1);
+
+        constexpr auto extremesC = MAKESHIFT_CONSTVAL(std::array{ std::uint64_t(0), std::numeric_limits<std::uint64_t>::max() });
+        CHECK(expanded_index(std::uint64_t(0), extremesC) == 0);
+        CHECK(expanded_index(std::numeric_limits<std::uint64_t>::max(), extremesC) == 1);
+        CHECK(expanded_index(std::uint64_t(1), extremesC) == -1);
+    }
+    SECTION("powers of two")
+    {
+        constexpr auto valuesC = MAKESHIFT_CONSTVAL(std::array{ 16, 32, 64, 128 });
+        static_assert(mk::detail::select_integral_value_search_strategy(mk::detail::to_search_keys<int>(valuesC.value)) == value_search_strategy::power_of_two);
+        CHECK(expanded_index(16, valuesC) == 0);
+        CHECK(expanded_index(64, valuesC) == 2);
+        CHECK(expanded_index(128, valuesC) == 3);
+        CHECK(expanded_index(8, valuesC) == -1);
+        CHECK(expanded_index(48, valuesC) == -1);
+        CHECK(expanded_index(256, valuesC) == -1);
+        CHECK(expanded_index(0, valuesC) == -1);
+        CHECK(expanded_index(-16, valuesC) == -1);
+    }
+    SECTION("lookup table")
+    {
+        constexpr auto valuesC = MAKESHIFT_CONSTVAL(std::array{ 7, 3, 19, -2, 11, 5 });
+        static_assert(mk::detail::select_integral_value_search_strategy(mk::detail::to_search_keys<int>(valuesC.value)) == value_search_strategy::lookup_table);
+        CHECK(expanded_index(7, valuesC) == 0);
+        CHECK(expanded_index(3, valuesC) == 1);
+        CHECK(expanded_index(-2, valuesC) == 3);
+        CHECK(expanded_index(19, valuesC) == 2);
+        CHECK(expanded_index(0, valuesC) == -1);
+        CHECK(expanded_index(-3, valuesC) == -1);
+        CHECK(expanded_index(20, valuesC) == -1);
+    }
+    SECTION("sorted search over sparse values")
+    {
+        constexpr auto valuesC = MAKESHIFT_CONSTVAL(std::array{ -104, 2, 1001, 13, 22, 4096, -1 });
+        static_assert(mk::detail::select_integral_value_search_strategy(mk::detail::to_search_keys<int>(valuesC.value)) == value_search_strategy::sorted);
+        CHECK(expanded_index(-104, valuesC) == 0);
+        CHECK(expanded_index(13, valuesC) == 3);
+        CHECK(expanded_index(4096, valuesC) == 5);
+        CHECK(expanded_index(-1, valuesC) == 6);
+        CHECK(expanded_index(-105, valuesC) == -1);
+        CHECK(expanded_index(5, valuesC) == -1);
+        CHECK(expanded_index(5000, valuesC) == -1);
+    }
+    SECTION("sorted search over floating-point values")
+    {
+        constexpr auto valuesC = MAKESHIFT_CONSTVAL(std::array{ 0.5, 8.25, -2., 4., 1.5 });
+        static_assert(mk::detail::select_value_search_strategy<double>(valuesC) == value_search_strategy::sorted);
+        CHECK(expanded_index(0.5, valuesC) == 0);
+        CHECK(expanded_index(-2., valuesC) == 2);
+        CHECK(expanded_index(1.5, valuesC) == 4);
+        CHECK(expanded_index(1., valuesC) == -1);
+        CHECK(expanded_index(9., valuesC) == -1);
+    }
+    SECTION("sorted search over many values")
+    {
+        constexpr auto valuesC = MAKESHIFT_CONSTVAL(make_many_values());
+        static_assert(mk::detail::select_value_search_strategy<double>(valuesC) == value_search_strategy::sorted);
+        static_assert(mk::detail::sort_values(valuesC.value).values[0] == 0.5);
+        static_assert(mk::detail::sort_values(valuesC.value).indices[1] == 1);
+        CHECK(mk::detail::search_value_index(0.5, valuesC) == 0);
+        CHECK(mk::detail::search_value_index(double(999*999 % 7919) + 0.5, valuesC) == 999);
+        CHECK(mk::detail::search_value_index(double(500*500 % 7919) + 0.5, valuesC) == 500);
+        CHECK(mk::detail::search_value_index(1., valuesC) == -1);
+        CHECK(mk::detail::search_value_index(1e6, valuesC) == -1);
+    }
+    SECTION("hashed lookup of strings")
+    {
+        constexpr auto valuesC = MAKESHIFT_CONSTVAL(std::array{ "gemm"sv, "gemv"sv, "axpy"sv, "dot"sv, "nrm2"sv, "scal"sv, "trsm"sv });
+        static_assert(mk::detail::select_value_search_strategy<std::string>(valuesC) == value_search_strategy::hashed);
+        static_assert(mk::detail::select_value_search_strategy<char const*>(valuesC) == value_search_strategy::hashed);
+        CHECK(expanded_index("gemm"s, valuesC) == 0);
+        CHECK(expanded_index("dot"s, valuesC) == 3);
+        CHECK(expanded_index("trsm", valuesC) == 6);
+        CHECK(expanded_index("gem"s, valuesC) == -1);
+        CHECK(expanded_index(""s, valuesC) == -1);
+
+        auto name = GENERATE("gemm"s, "gemv"s, "axpy"s, "dot"s, "nrm2"s, "scal"s, "trsm"s);
+        auto nameV = mk::expand(name, valuesC);
+        CHECK(mk::visit([](auto nameC) { return std::string(nameC()); }, nameV) == name);
+    }
+    SECTION("hashed lookup of structs with reflected members")
+    {
+        constexpr auto valuesC = MAKESHIFT_CONSTVAL(std::array{
+            Precision{ 16, false }, Precision{ 32, false }, Precision{ 32, true }, Precision{ 64, false }, Precision{ 64, true } });
+        static_assert(mk::detail::select_value_search_strategy<Precision>(valuesC) == value_search_strategy::hashed);
+        CHECK(expanded_index(Precision{ 16, false }, valuesC) == 0);
+        CHECK(expanded_index(Precision{ 32, true }, valuesC) == 2);
+        CHECK(expanded_index(Precision{ 64, true }, valuesC) == 4);
+        CHECK(expanded_index(Precision{ 16, true }, valuesC) == -1);
+        CHECK(expanded_index(Precision{ 128, false }, valuesC) == -1);
+    }
+    SECTION("duplicate values fall back to sorted search")
+    {
+        constexpr auto valuesC = MAKESHIFT_CONSTVAL(std::array{ "gemm"sv, "gemv"sv, "axpy"sv, "gemv"sv, "nrm2"sv, "scal"sv });
+        static_assert(!mk::detail::perfect_hash_<std::remove_const_t<decltype(valuesC)>>::table.valid);
+        static_assert(mk::detail::select_value_search_strategy<std::string>(valuesC) == value_search_strategy::sorted);
+        CHECK(expanded_index("gemm"s, valuesC) == 0);
+        CHECK(expanded_index("axpy"s, valuesC) == 2);
+        CHECK(expanded_index("scal"s, valuesC) == 5);
+        CHECK(expanded_index("dot"s, valuesC) == -1);
+
+        auto index = expanded_index("gemv"s, valuesC);
+        CHECK((index == 1 || index == 3));
+    }
+}
+
+
+TEST_CASE("constval_variant<>")
+{
+    auto bitsValuesC = MAKESHIFT_CONSTVAL(std::array{ 16, 32, 64 });
+    using BitsV = mk::constval_variant<decltype(bitsValuesC)>;
+    static_assert(sizeof(BitsV) == 1);
+    static_assert(std::is_trivially_copyable_v<BitsV>);
+
+    auto bits = GENERATE(16, 32, 64);
+    auto bitsV = mk::expand_compact(bits, bitsValuesC);
+    CHECK(bitsV.value() == bits);
+    CHECK(mk::visit([](auto bitsC) { return bitsC(); }, bitsV) == bits);
+    CHECK(mk::visit<mk::visit_dispatch::jump_table>([](auto bitsC) { return bitsC(); }, bitsV) == bits);
+
+    BitsV::variant_type bitsStdV = bitsV;
+    CHECK(bitsStdV.index() == bitsV.index());
+    CHECK(BitsV(bitsStdV) == bitsV);
+    CHECK(BitsV(mk::expand(bits, bitsValuesC)) == bitsV);
+
+    auto loggingV = mk::expand_compact(true);
+    CHECK(loggingV.value());
+    CHECK(mk::visit([](auto bitsC, auto loggingC) { return bitsC() + int(loggingC()); }, bitsV, loggingV) == bits + 1);
+    CHECK(mk::visit([](auto bitsC, auto loggingC) { return bitsC() + int(loggingC()); }, bitsStdV, loggingV) == bits + 1);
+
+    CHECK(mk::get<0>(BitsV::from_index(0))() == 16);
+    CHECK_THROWS_AS(mk::get<1>(BitsV::from_index(0)), std::bad_variant_access);
+    CHECK_THROWS_AS(BitsV::from_index(3), gsl::fail_fast);
+    CHECK_THROWS_AS(mk::expand_compact(42, bitsValuesC), mk::unsupported_runtime_value);
+
+    constexpr auto manyValuesC = MAKESHIFT_CONSTVAL(std::array{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20 });
+    auto manyV = mk::expand_compact(19, manyValuesC);
+    CHECK(mk::visit([](auto valueC) { return valueC(); }, manyV) == 19);
+}
+
+TEST_CASE("constval_variant<> with more alternatives than std::variant<> supports")
+{
+        // `std::variant<>` with 1000 alternatives exceeds the instantiation depth limits of some standard libraries, but
+        // `constval_variant<>` never needs its `variant_type` to be complete.
+    constexpr auto valuesC = MAKESHIFT_CONSTVAL(make_many_values());
+    using ValueV = mk::constval_variant<std::remove_const_t<decltype(valuesC)>>;
+    static_assert(sizeof(ValueV) == 2);
+
+    auto index = GENERATE(std::size_t(0), std::size_t(123), numManyValues - 1);
+    double value = make_many_values()[index];
+    auto valueV = mk::expand_compact(value, valuesC);
+    CHECK(valueV.index() == index);
+    CHECK(valueV.value() == value);
+    auto copiedV = valueV;
+    CHECK(copiedV == valueV);
+    CHECK(mk::get<0>(ValueV::from_index(0))() == 0.5);
+    CHECK(mk::get<numManyValues - 1>(ValueV::from_index(numManyValues - 1))() == make_many_values().back());
+    CHECK_THROWS_AS(mk::get<1>(ValueV::from_index(0)), std::bad_variant_access);
+}
+
+TEST_CASE("visit_batched()")
+{
+    auto bitsValuesC = MAKESHIFT_CONSTVAL(std::array{ 16, 32, 64 });
+    struct WorkItem
+    {
+        int id;
+        mk::constval_variant<decltype(bitsValuesC)> bitsV;
+        bool logging;
+    };
+    auto items = std::vector<WorkItem>{ };
+    for (int i = 0; i != 20; ++i)
+    {
+        items.push_back({ i, mk::expand_compact(std::array{ 64, 16, 32 }[i % 3], bitsValuesC), i % 4 == 0 });
+    }
+
+    auto batches = std::vector<std::tuple<int, bool, std::vector<int>>>{ };
+    mk::visit_batched(
+        [&batches](std::span<WorkItem> batch, auto bitsC, auto loggingC)
+        {
+            auto ids = std::vector<int>{ };
+            for (WorkItem const& item : batch)
+            {
+                CHECK(item.bitsV.value() == bitsC());
+                CHECK(item.logging == loggingC());
+                ids.push_back(item.id);
+            }
+            batches.emplace_back(bitsC(), loggingC(), ids);
+        },
+        items,
+        [](WorkItem const& item) { return item.bitsV; },
+        [](WorkItem const& item) { return mk::expand(item.logging); });
+
+        // Batches are visited in order of the combined index, and items keep their relative order within a batch.
+    auto expectedBatches = std::vector<std::tuple<int, bool, std::vector<int>>>{
+        { 16, false, { 1, 7, 10, 13, 19 } },
+        { 32, false, { 2, 5, 11, 14, 17 } },
+        { 64, false, { 3, 6, 9, 15, 18 } },
+        { 16, true, { 4, 16 } },
+        { 32, true, { 8 } },
+        { 64, true, { 0, 12 } }
+    };
+    CHECK(batches == expectedBatches);
+    REQUIRE(items.size() == 20);
+    CHECK(items.front().id == 1);
+    CHECK(items.back().id == 12);
+}
+
+TEST_CASE("expand_all()")
+{
+    auto bitsValuesC = MAKESHIFT_CONSTVAL(std::array{ 16, 32, 64 });
+    auto loggingValuesC = MAKESHIFT_CONSTVAL(std::array{ false, true });
+    auto bits = GENERATE(16, 32, 64);
+    auto logging = GENERATE(false, true);
+
+    auto paramsV = mk::expand_all(bits, logging, bitsValuesC, loggingValuesC);
+    static_assert(std::variant_size_v<decltype(paramsV)> == 6);
+    auto result = mk::visit(
+        [](auto paramsC)
+        {
+            return std::apply(
+                [](auto bitsC, auto loggingC)
+                {
+                    constexpr int bitsValue = bitsC();
+                    constexpr bool loggingValue = loggingC();
+                    return std::pair(bitsValue, loggingValue);
+                },
+                paramsC);
+        },
+        paramsV);
+    CHECK(result == std::pair(bits, logging));
+
+    CHECK_THROWS_AS(mk::expand_all(bits, 8, bitsValuesC, bitsValuesC), mk::unsupported_runtime_value);
+}
+
+TEST_CASE("visit_specialized()")
+{
+    auto hotValuesC = MAKESHIFT_CONSTVAL(std::array{ std::tuple{ 32, false }, std::tuple{ 64, true } });
+    auto func = [](auto bits, auto logging)
+    {
+        constexpr bool specialized = mk::is_constval_v<decltype(bits)>;
+        static_assert(mk::is_constval_v<decltype(logging)> == specialized);
+        return std::tuple{ specialized, int(bits), bool(logging) };
+    };
+
+    SECTION("hot combinations are specialized")
+    {
+        CHECK(mk::visit_specialized(func, std::tuple{ 32, false }, hotValuesC) == std::tuple{ true, 32, false });
+        CHECK(mk::visit_specialized(func, std::tuple{ 64, true }, hotValuesC) == std::tuple{ true, 64, true });
+    }
+    SECTION("other combinations fall back to the generic implementation")
+    {
+        CHECK(mk::visit_specialized(func, std::tuple{ 32, true }, hotValuesC) == std::tuple{ false, 32, true });
+        CHECK(mk::visit_specialized(func, std::tuple{ 16, false }, hotValuesC) == std::tuple{ false, 16, false });
+    }
+    SECTION("single values")
+    {
+        auto square = [](auto x) { return int(x)*int(x); };
+        CHECK(mk::visit_specialized(square, 3, MAKESHIFT_CONSTVAL(std::array{ 1, 2, 3 })) == 9);
+        CHECK(mk::visit_specialized(square, 4, MAKESHIFT_CONSTVAL(std::array{ 1, 2, 3 })) == 16);
+    }
+}
 
 } // anonymous namespace